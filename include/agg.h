@@ -0,0 +1,70 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      agg.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Wire format and limits of the small-frame aggregation of the `builtin:agg` controller stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: IEEE 802.11n A-MSDU (aggregation of small frames in one transmission).
+ *
+ *            A packet starts with the number of frames it holds, followed by every frame but the last prefixed with its
+ *            length, one byte below 0x80, otherwise two bytes big endian with the high bit set, and by the last frame,
+ *            which runs to the end of the packet.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef AGG_H
+#define AGG_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_AGG_MAX          255                                           //!< Default longest packet, argument `max`, the payload of a LoRa packet
+#define MIXLINK_AGG_MAX_SIZE     2048                                          //!< Largest `max` accepted
+#define MIXLINK_AGG_HOLD_MS      20                                            //!< Default wait for more frames after the first one, argument `hold`
+#define MIXLINK_AGG_HOLD_MAX_MS  1000
+#define MIXLINK_AGG_FRAMES       16                                            //!< Most frames in a packet, also the outputs of a reception
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
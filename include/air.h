@@ -0,0 +1,153 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      air.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Time on air of the LoRa packets, duty cycle budget and rate shaper that pace the serial writes of the TX direction.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: Semtech AN1200.13 (LoRa modem designer's guide), SX1276 datasheet section 4.1.1.7, ETSI EN 300 220-2.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef AIR_H
+#define AIR_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mixlinkabi.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_AIR_PREAMBLE  8                                                //!< Preamble symbols when the driver gives none
+#define MIXLINK_AIR_PAYLOAD   255                                              //!< Longest LoRa packet, when the driver gives no shorter one
+#define MIXLINK_AIR_WINDOW    60                                               //!< Default seconds of duty cycle the budget can hold, argument `window` of the driver, up to 3600
+#define MIXLINK_AIR_POLL_MS   5                                                //!< Interval between two checks of a transceiver that is not ready
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Airtime budget and rate shaper of the serial writes, only touched by the TX thread
+typedef struct{
+  mixlink_abi_radio_t radio;                                                   //!< Modulation from the driver and its arguments
+  int64_t tokens;                                                              //!< Nanoseconds of airtime that may still be used, below 0 after a packet longer than the budget
+  int64_t capacity;                                                            //!< 0 without a modulation or a duty cycle
+  uint64_t level;                                                              //!< Millionths of the bytes written that the transceiver has not sent yet
+  uint32_t burst;                                                              //!< Bytes the transceiver is given ahead of what it sends
+  uint64_t last;                                                               //!< When `tokens` and `level` were last updated, in microseconds
+} mixlink_air_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Microseconds a write takes on air, split into packets of at most `payload` bytes.
+ *
+ * The symbols of each packet follow the SX127x formula: the preamble plus 4.25 symbols, then 8 symbols and the payload,
+ * header and CRC coded in groups of `4 * (sf - 2 * de)` bits, where `de` is set when a symbol lasts more than 16 ms.
+ *
+ * @param[in] radio The modulation, `sf` and `bw` must be set.
+ * @param[in] len Bytes written to the serial port.
+ *
+ * @return The airtime in microseconds, 0 if the modulation is unknown.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+uint64_t mixlink_air_time(
+  const mixlink_abi_radio_t * radio,
+  const size_t len
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Takes the modulation reported by the driver, the driver arguments `sf`, `bw`, `cr`, `preamble`, `crc`, `implicit`,
+ *        `payload`, `duty`, `buffer` and `rate` override it, and fills the budget of `window` seconds of duty cycle.
+ *
+ * Writes are shaped to `rate` bytes per second, by default the rate of full packets on air, keeping at most `burst` bytes
+ * in the transceiver, by default two packets so the next one is ready when the last ends, never above `buffer`.
+ *
+ * @param[out] air The pacer object.
+ * @param[in] radio The modulation filled by the driver during init, NULL if there is no driver.
+ * @param[in] args The arguments of the driver, e.g., "sf=9&bw=125000&cr=5&duty=10".
+ *
+ * @return Upon success it returns 0, the pacer stays disabled without a modulation, a duty cycle or a rate. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ *  - `EINVAL`: Invalid argument, e.g., a spreading factor out of range \n
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_air_init(
+  mixlink_air_t * air,
+  const mixlink_abi_radio_t * radio,
+  const char * args
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Milliseconds before a write of `len` bytes fits the budget and the transceiver, a write longer than either waits
+ *        for a full budget or an empty transceiver.
+ *
+ * @param[in,out] air The pacer object.
+ * @param[in] len Bytes of the write.
+ *
+ * @return 0 if the write may start now.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+uint32_t mixlink_air_wait(
+  mixlink_air_t * air,
+  const size_t len
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Charges the airtime of a write of `len` bytes to the budget and its bytes to the transceiver.
+ *
+ * @param[in,out] air The pacer object.
+ * @param[in] len Bytes written.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_air_sent(
+  mixlink_air_t * air,
+  const size_t len
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,80 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      arq.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Wire format and limits of the selective-repeat ARQ of the `builtin:sr` QoS stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: RFC 2018 (SACK), RFC 6298 (retransmission timer), RFC 8985 (RACK).
+ *
+ *            Every segment starts with a flags byte, whose high nibble is the length of the SACK bitmap in bytes, followed by
+ *            the sequence number of a data segment and, when the flags carry an acknowledgement, the next sequence number
+ *            expected and the SACK bitmap, all little endian. Bit `i` of the bitmap acknowledges the segment `ack + 1 + i`.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef ARQ_H
+#define ARQ_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_ARQ_DATA         0x01                                          //!< The segment carries a sequence number and a payload
+#define MIXLINK_ARQ_ACK          0x02                                          //!< The segment carries the acknowledgement of the reverse direction
+#define MIXLINK_ARQ_SYNC         0x04                                          //!< The sender has not been acknowledged yet, the receiver may restart at this sequence number
+#define MIXLINK_ARQ_HDR_MAX      13                                            //!< Flags, sequence number, acknowledgement and the longest bitmap
+
+#define MIXLINK_ARQ_QUEUE        128                                           //!< Segments queued or in flight, power of two
+#define MIXLINK_ARQ_WINDOW_MAX   64                                            //!< Largest window, also the reorder buffer of the receiver and the reach of the bitmap
+#define MIXLINK_ARQ_WINDOW       32                                            //!< Default window, argument `window`
+#define MIXLINK_ARQ_MAX_SEGMENT  2048                                          //!< Longest payload accepted
+#define MIXLINK_ARQ_DELAY_MS     20                                            //!< Default wait for reverse traffic before an acknowledgement is sent alone, argument `delay`
+#define MIXLINK_ARQ_RTO_INIT_MS  1000                                          //!< Retransmission timeout before the first round trip is measured
+#define MIXLINK_ARQ_RTO_MIN_MS   100
+#define MIXLINK_ARQ_RTO_MAX_MS   16000                                         //!< Also the limit of the exponential backoff
+#define MIXLINK_ARQ_DUPTHRESH    3                                             //!< Segments acknowledged after a later transmission that declare an earlier one lost
+#define MIXLINK_ARQ_REPORT       64                                            //!< First transmissions between two loss reports to the link policy
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,640 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      builtin.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Stack modules linked into the binary, selected with `builtin:<name>` instead of a library path.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef BUILTIN_H
+#define BUILTIN_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+
+#include "mixlink.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_BUILTIN_PREFIX "builtin:"                                      //!< Module paths starting with it name a built-in module, e.g., "builtin:cobs"
+
+//!< The built-in modules, X( name, init, rx, tx, deinit ), NULL for a function not implemented
+#define MIXLINK_BUILTIN_MODULES                                                                                                  \
+  X( cobs,   mixlink_builtin_cobs_init,   mixlink_builtin_cobs_rx,   mixlink_builtin_cobs_tx,   mixlink_builtin_cobs_deinit   ) \
+  X( cobsr,  mixlink_builtin_cobsr_init,  mixlink_builtin_cobsr_rx,  mixlink_builtin_cobsr_tx,  mixlink_builtin_cobs_deinit   ) \
+  X( crc32c, NULL,                        mixlink_builtin_crc32c_rx, mixlink_builtin_crc32c_tx, NULL                          ) \
+  X( crc16,  NULL,                        mixlink_builtin_crc16_rx,  mixlink_builtin_crc16_tx,  NULL                          ) \
+  X( rs,     mixlink_builtin_rs_init,     mixlink_builtin_rs_rx,     mixlink_builtin_rs_tx,     mixlink_builtin_rs_deinit     ) \
+  X( sr,     mixlink_builtin_sr_init,     mixlink_builtin_sr_rx,     mixlink_builtin_sr_tx,     mixlink_builtin_sr_deinit     ) \
+  X( rohc,   mixlink_builtin_rohc_init,   mixlink_builtin_rohc_rx,   mixlink_builtin_rohc_tx,   mixlink_builtin_rohc_deinit   ) \
+  X( eth,    mixlink_builtin_eth_init,    mixlink_builtin_eth_rx,    mixlink_builtin_eth_tx,    mixlink_builtin_eth_deinit    ) \
+  X( lz,     mixlink_builtin_lz_init,     mixlink_builtin_lz_rx,     mixlink_builtin_lz_tx,     mixlink_builtin_lz_deinit     ) \
+  X( agg,    mixlink_builtin_agg_init,    mixlink_builtin_agg_rx,    mixlink_builtin_agg_tx,    mixlink_builtin_agg_deinit    ) \
+  X( prio,   mixlink_builtin_prio_init,   NULL,                      mixlink_builtin_prio_tx,   mixlink_builtin_prio_deinit   ) \
+  X( tdma,   mixlink_builtin_tdma_init,   mixlink_builtin_tdma_rx,   mixlink_builtin_tdma_tx,   mixlink_builtin_tdma_deinit   )
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< A built-in module, the functions take the same arguments as the `<prefix>_<suffix>` symbols of a library, NULL if not implemented
+typedef struct{
+  const char * name;
+  uint32_t version;
+  int8_t (* init)( void * );
+  int8_t (* loop)( void * );
+  int8_t (* rx)( void * );
+  int8_t (* tx)( void * );
+  int8_t (* deinit)( void * );
+  int8_t (* rx_batch)( void * );
+  int8_t (* tx_batch)( void * );
+} mixlink_builtin_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Finds a built-in module by name.
+ *
+ * @param[in] name The name without `MIXLINK_BUILTIN_PREFIX`, e.g., "cobs".
+ *
+ * @return The module, or NULL with errno set to `ENOENT` if there is no built-in module with that name.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+const mixlink_builtin_t * mixlink_builtin_find(
+  const char * name
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the deframer of a `builtin:cobs` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance, `priv` is set.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_cobs_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the deframer of a `builtin:cobsr` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance, `priv` is set.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_cobsr_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the deframer of a `builtin:cobs` or `builtin:cobsr` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance, `priv` is cleared.
+ *
+ * @return 0.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_cobs_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief COBS framer, encodes a buffer and terminates it with a 0x00 delimiter.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input and at least one output.
+ *
+ * @return 0 with one output, or -1 if the output is too small for the encoded frame.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_cobs_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief COBS deframer, decodes each 0x00 delimited frame into its own output as soon as its delimiter arrives.
+ *
+ * The input may hold any part of the byte stream, e.g., a partial read of the serial port, a frame spans as many calls as needed
+ * and each byte is scanned once. Input left once every output is used is kept and decoded on a call scheduled right away.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input, or none when called back.
+ *
+ * @return 0 with the decoded frames, or 1 if no frame was completed, malformed frames are dropped.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_cobs_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief COBS/R framer, as `mixlink_builtin_cobs_tx()` but the last code byte is dropped when the last data byte can replace it.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input and at least one output.
+ *
+ * @return 0 with one output, or -1 if the output is too small for the encoded frame.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_cobsr_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief COBS/R deframer, as `mixlink_builtin_cobs_rx()`.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input, or none when called back.
+ *
+ * @return 0 with the decoded frames, or 1 if no frame was completed.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_cobsr_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief CRC32C integrity check, copies the buffer and appends its checksum.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input and at least one output.
+ *
+ * @return 0 with one output, or -1 if the output is too small for the trailer.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_crc32c_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief CRC32C integrity check, verifies and removes the trailer and counts the result in `link`.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input and at least one output.
+ *
+ * @return 0 with the payload as a slice of the input, or 1 if the frame is corrupted and was dropped.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_crc32c_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief CRC16 integrity check, as `mixlink_builtin_crc32c_tx()` with a 2 byte trailer.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input and at least one output.
+ *
+ * @return 0 with one output, or -1 if the output is too small for the trailer.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_crc16_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief CRC16 integrity check, as `mixlink_builtin_crc32c_rx()` with a 2 byte trailer.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input and at least one output.
+ *
+ * @return 0 with the payload as a slice of the input, or 1 if the frame is corrupted and was dropped.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_crc16_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the coder of a `builtin:rs` instance, from the arguments `k`, `m` and `hold`, e.g., "builtin:rs?k=8&m=2".
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success, or -1 if an argument is out of range or the allocation fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_rs_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the coder of a `builtin:rs` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_rs_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Reed-Solomon encoder, sends the segment with its block header and, once the block closes, its repair segments.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with at most one input, none when woken to close a block or send repairs.
+ *
+ * @return 0 with the segment and any repairs ready, or 1 if there was nothing to send.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_rs_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Reed-Solomon decoder, passes source segments through and rebuilds the lost ones once enough repairs arrive.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one input and at least one output.
+ *
+ * @return 0 with the segment and any rebuilt ones, or 1 if the input was a repair that rebuilt nothing.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_rs_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the state of a `builtin:sr` instance, from the arguments `window`, `delay` and `adapt`, e.g., "builtin:sr?window=32".
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success, or -1 if an argument is out of range or the allocation fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_sr_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the state of a `builtin:sr` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_sr_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Selective-repeat sender, queues the segment and sends what the window, the timeouts and the acknowledgements allow.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with at most one input, none when woken by a timeout or by the receiver.
+ *
+ * @return 0 with the segments ready, 1 if nothing can be sent now, or -1 if the queue is full, which sets `full` so the core stops feeding it beforehand.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_sr_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Selective-repeat receiver, takes the acknowledgement for the sender and delivers the data in order.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with at most one input, none when woken to deliver held segments.
+ *
+ * @return 0 with the segments delivered, or 1 if the input was held, a duplicate or only an acknowledgement.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_sr_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the contexts of a `builtin:rohc` instance, from the argument `eth`, 0 when the frames start at the IP header, e.g., "builtin:rohc?eth=0" for a TUN,
+ *        or `l2`, the bytes before the IP header, e.g., "builtin:rohc?l2=2" behind `builtin:eth`.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success, or -1 if `l2` is out of range or the allocation fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_rohc_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the contexts of a `builtin:rohc` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_rohc_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Header compressor, replaces the headers of a known flow by the fields that did not follow its last packet.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one frame.
+ *
+ * @return 0 on success, or -1 if the output cannot hold the frame.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_rohc_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Header decompressor, rebuilds the frame from the context of its flow.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one compressed frame.
+ *
+ * @return 0 on success, or -1 if the context is unknown or the rebuilt header fails its CRC.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_rohc_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the header tables of a `builtin:eth` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success, or -1 if the allocation fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_eth_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the header tables of a `builtin:eth` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_eth_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Ethernet header elision, replaces a header already sent by its context identifier.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one frame.
+ *
+ * @return 0 on success, or -1 if the output cannot hold the frame.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_eth_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Ethernet header restoration, puts back the header of the context named by the frame.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one elided frame.
+ *
+ * @return 0 on success, or -1 if the context was never set up or the frame is malformed.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_eth_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Loads the dictionary of a `builtin:lz` instance, from the arguments `dict`, `min`, `budget` and `baud`, e.g., "builtin:lz?dict=/etc/mixlink/mqtt.dict&baud=9600".
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success, or -1 if an argument is out of range, the dictionary cannot be read or the allocation fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_lz_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the dictionary of a `builtin:lz` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_lz_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Payload compressor, sends the frame as a block when it is shorter and worth the time, as is otherwise.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one frame.
+ *
+ * @return 0 on success, or -1 if the output cannot hold the frame.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_lz_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Payload decompressor.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one frame.
+ *
+ * @return 0 on success, or -1 if the block is malformed or was compressed with another dictionary.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_lz_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the state of a `builtin:agg` instance, from the arguments `max` and `hold`, e.g., "builtin:agg?max=255&hold=20".
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success, or -1 if an argument is out of range or the allocation fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_agg_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the state of a `builtin:agg` instance.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_agg_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Aggregator, holds the frame until the packet is full or the hold-off expires, unless the link was quiet.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with at most one input, none when woken by the hold-off, and two outputs.
+ *
+ * @return 0 with the packets ready, 1 if the frame was held, or -1 if an output cannot hold a packet.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_agg_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief De-aggregator, splits a packet into its frames, those the outputs cannot take are kept for the next kick.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one packet, or none when woken to deliver the frames kept.
+ *
+ * @return 0 with the frames ready, 1 if none was, or -1 if the packet is malformed or too many frames are kept.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_agg_rx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the state of a `builtin:prio` instance, from the arguments `ports`, `strict`, `quantum`, `depth`, `target`, `interval`, `ecn` and `eth`, e.g., "builtin:prio?ports=22:1,873:3&target=500".
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success, or -1 if an argument is out of range or the allocation fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_prio_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the state of a `builtin:prio` instance and the frames still queued.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_prio_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Scheduler, queues the frame in its flow and lets the next ones through while fewer than `depth` buffers wait for the serial port, CoDel dropping or marking those that waited too long.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with at most one input, none when called after the serial port took a buffer.
+ *
+ * @return 0 with the frames let through, 1 if none was, or -1 if the frame is longer than `MIXLINK_PRIO_FRAME_MAX`.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_prio_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates the state of a `builtin:tdma` instance, from the arguments `mode`, `id`, `weights`, `slot`, `guard`, `quantum`, `gap`, `hold` and `timeout`, e.g., "builtin:tdma?mode=token&id=0&weights=2,1".
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success, or -1 if an argument is out of range or the allocation fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_tdma_init(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the state of a `builtin:tdma` instance and the frames still waiting for their turn.
+ *
+ * @param[in,out] arg The `mixlink_abi_def_t` of the instance.
+ *
+ * @return 0 on success.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_tdma_deinit(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Turn-taking, holds the frame until the slots of the node or the token, then sends one frame at a time.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with at most one input, none when woken for a turn.
+ *
+ * @return 0 with the frames sent, 1 if none was, or -1 if the frame does not fit the queue, which sets `full` so the core stops feeding it beforehand.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_tdma_tx(
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Strips the turn-taking header, takes the token handed to the node and wakes the sender.
+ *
+ * @param[in,out] arg A `mixlink_abi_gen_io_t` with one frame.
+ *
+ * @return 0 on success, 1 for a frame that only passes the token, or -1 if the frame is malformed.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_builtin_tdma_rx(
+  void * arg
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Direct calls
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+// `mixlink_builtin_<name>_io()` calls the IO function of a built-in module for the direction given, the fixed stack binds its
+// stages to them at build time so the link-time optimizer can inline the modules into the pipeline
+#define X( name, init, rx, tx, deinit )                                      \
+  static inline int8_t                                                       \
+  mixlink_builtin_##name##_io(                                               \
+    void * abi,                                                              \
+    const enum direction dir                                                 \
+  ){                                                                         \
+    int8_t (* const fn)( void * ) = ( MIXLINK_DIRECTION_TO_NIC == dir ) ? rx : tx; \
+    return fn ? fn( abi ) : 0;                                               \
+  }
+MIXLINK_BUILTIN_MODULES
+#undef X
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
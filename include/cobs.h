@@ -0,0 +1,203 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      cobs.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Consistent Overhead Byte Stuffing (COBS) and COBS/R codec, with SIMD delimiter scans selected at runtime.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: S. Cheshire and M. Baker, "Consistent Overhead Byte Stuffing", IEEE/ACM ToN, 1999.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef COBS_H
+#define COBS_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_COBS_DELIMITER 0x00                                            //!< Byte that never appears inside an encoded frame
+#define MIXLINK_COBS_MAX_ENCODED( len ) ( (len) + (len) / 254 + 1 )           //!< Worst case size of `len` bytes once encoded, without the delimiter
+#define MIXLINK_COBS_WINDOW    4096                                            //!< Bytes the built-in deframer holds, a longer frame is dropped up to the next delimiter to resync
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Resumable decoder, the frame is written to `dst` as its blocks arrive
+typedef struct{
+  uint8_t * dst;
+  size_t size;                                                                 //!< Capacity of `dst`
+  size_t len;                                                                  //!< Bytes of the frame decoded so far
+  uint8_t code;                                                                //!< Code byte of the current block, 0 before the first block of the frame
+  uint8_t left;                                                                //!< Data bytes still expected in the current block
+  bool broken;                                                                 //!< The frame is discarded up to its delimiter
+  int err;                                                                     //!< errno reported once the broken frame ends
+  bool reduced;                                                                //!< COBS/R, a block cut short by the delimiter ends with its own code byte
+} mixlink_cobs_stream_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Finds the first 0x00 byte, 16 or 32 bytes at a time with SSE2, AVX2 or NEON when the CPU has them.
+ *
+ * @param[in] src The data to scan.
+ * @param[in] len The number of bytes of `src`.
+ *
+ * @return The index of the first 0x00, or `len` if there is none.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+size_t mixlink_cobs_scan(
+  const uint8_t * src,
+  const size_t len
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Name of the scan implementation picked for this CPU, e.g., "avx2".
+ *
+ * @return The name.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+const char * mixlink_cobs_impl(
+  void
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Encodes `len` bytes, the output has no 0x00 and no delimiter.
+ *
+ * @param[in] src The data to encode.
+ * @param[in] len The number of bytes of `src`.
+ * @param[out] dst At least `MIXLINK_COBS_MAX_ENCODED(len)` bytes, it must not overlap `src`.
+ * @param[in] reduced COBS/R, the last code byte is replaced by the last data byte when that is larger, saving one byte.
+ *
+ * @return The number of bytes written to `dst`.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+size_t mixlink_cobs_encode(
+  const uint8_t * src,
+  const size_t len,
+  uint8_t * dst,
+  const bool reduced
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Decodes one encoded frame, without its delimiter.
+ *
+ * @param[in] src The encoded frame.
+ * @param[in] len The number of bytes of `src`.
+ * @param[out] dst The decoded data, it must not overlap `src`.
+ * @param[in] size The capacity of `dst`.
+ * @param[in] reduced The frame was encoded as COBS/R.
+ *
+ * @return The number of bytes written to `dst`, or -1 with errno set.
+ *
+ *  - `EBADMSG`: The frame holds a 0x00 or a code that runs past its end \n
+ *  - `EMSGSIZE`: `dst` is too small \n
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+ptrdiff_t mixlink_cobs_decode(
+  const uint8_t * src,
+  const size_t len,
+  uint8_t * dst,
+  const size_t size,
+  const bool reduced
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Starts decoding a new frame into `dst`, the stream keeps its mode.
+ *
+ * @param[out] stream The decoder.
+ * @param[out] dst The buffer of the decoded frame, it must not overlap the encoded data.
+ * @param[in] size The capacity of `dst`.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_cobs_stream_reset(
+  mixlink_cobs_stream_t * stream,
+  uint8_t * dst,
+  const size_t size
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Decodes encoded bytes as they arrive, the state is kept between calls so a frame may span any number of chunks.
+ *
+ * Each byte is looked at once, the call returns as soon as the delimiter of a frame is consumed.
+ * Empty frames, i.e., consecutive delimiters, are skipped as idle fill.
+ *
+ * @param[in,out] stream The decoder.
+ * @param[in] src The encoded bytes that follow the ones already given.
+ * @param[in] len The number of bytes of `src`.
+ * @param[out] used The number of bytes of `src` consumed.
+ *
+ * @return 1 once a frame of `stream->len` bytes is complete in `stream->dst`, the stream is then reset before the next frame. \n
+ *         0 if `src` was consumed without completing a frame. \n
+ *         Otherwise -1 is returned, errno is set, and the bytes of the broken frame up to its delimiter are consumed.
+ *
+ *  - `EBADMSG`: The frame ended in the middle of a block \n
+ *  - `EMSGSIZE`: The frame does not fit `dst` \n
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_cobs_stream_feed(
+  mixlink_cobs_stream_t * stream,
+  const uint8_t * src,
+  const size_t len,
+  size_t * used
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Ends the current frame as if its delimiter arrived, for frames handed over without one.
+ *
+ * @param[in,out] stream The decoder.
+ *
+ * @return The same as `mixlink_cobs_stream_feed()`, 0 if no byte of a frame was given.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_cobs_stream_end(
+  mixlink_cobs_stream_t * stream
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
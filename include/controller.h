@@ -32,6 +32,8 @@
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
 #include "mixlink.h"
+#include "link.h"
+#include "air.h"
 #include <xcserial.h>
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -50,6 +52,12 @@ extern "C" {
 struct serial_handler{
   serial_t sr;
   mixlink_module_t driver;
+  mixlink_abi_radio_t radio;                                                   //!< Modulation reported by the driver, read by the airtime pacer
+  mixlink_abi_ready_fn_t ready;                                                //!< Flow control hook set by the driver through `mixlink_abi_io_serial_t`
+  void * ready_ctx;
+  bool cts;                                                                    //!< Without `ready`, writes wait for the CTS line, from the argument `cts` of the driver
+  pthread_rwlock_t lock;                                                       //!< Taken shared by every use of `sr` and exclusively by a reopen, the RX and TX threads may share the port
+  uint32_t gen;                                                                //!< Reopens of `sr` so far, a thread that saw an error reopens only if nobody did since
   bool enabled;
 };
 
@@ -60,9 +68,17 @@ typedef struct{
     struct serial_handler tx;
   } pair;
 
+  mixlink_module_t sched;                                                      //!< Scheduler of the frames from the NIC, paced by the serial port, first of the TX direction
   mixlink_module_t segm;
   mixlink_module_t qos;
   mixlink_module_t framer;
+  mixlink_module_t agg;                                                        //!< Aggregation of small frames between the segmenter and the QoS
+  mixlink_module_t fec;                                                        //!< Forward error correction between the QoS and the integrity check
+  mixlink_module_t check;                                                      //!< Integrity check between the QoS and the framer
+  mixlink_module_t mac;                                                        //!< Turn-taking of the half-duplex channel between the FEC and the integrity check
+  mixlink_abi_link_t link;                                                     //!< Counters of the serial link, handed to every stage
+  mixlink_link_policy_t policy;                                                //!< Retunes the FEC and the ARQ from `link`, run by the TX thread
+  mixlink_air_t air;                                                           //!< Paces the serial writes to the duty cycle of the radio, run by the TX thread
 } mixlink_controller_t;
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -115,6 +131,19 @@ size_t mixlink_controller_write(
   mixlink_buf8_t * data
 );
 
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Tells whether the transceiver of the TX serial port takes more data, from the `ready` hook of its driver, or from the
+ *        CTS line when the driver argument `cts` is set.
+ * 
+ * @param[in] controller The controller object that will be used.
+ * 
+ * @return True if a write may start now, also when the state cannot be read.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+bool mixlink_controller_ready(
+  mixlink_controller_t * controller
+);
+
 /**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
  * @brief Reads a specified number of bytes from the serial port buffer and writes to a buffer passed as argument.
  * 
@@ -125,7 +154,8 @@ size_t mixlink_controller_write(
  * @param[in] controller The controller object that will be used.
  * 
  * @return Upon success, the function returns the number of bytes wrote to the NIC buffer. \n
- *         On error, the function returns 0 and sets `errno` to indicate the error.
+ *         On error, the function returns 0 and sets `errno` to indicate the error, `ENODEV` or `EIO` if the port is gone,
+ *         which the caller reopens with `mixlink_controller_reopen()`.
  * 
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 size_t mixlink_controller_read( 
@@ -135,6 +165,42 @@ size_t mixlink_controller_read(
   mixlink_controller_t * controller
 );
 
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Reopens the serial port serving the direction given, e.g., after it was unplugged, unless it was reopened since `gen`.
+ * 
+ * @param[in] dir Indication of the flow of information.
+ * @param[in] controller The controller object.
+ * @param[in] gen The value of `mixlink_controller_gen()` when the port was last seen working.
+ * @param[in] iterations The attempts of `serial_reopen()`.
+ *
+ * @return Upon success, or if another thread already reopened the port, it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ * 
+ *  - `ENODEV`: The port could not be opened again \n
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_controller_reopen(
+  const enum direction dir,
+  mixlink_controller_t * controller,
+  const uint32_t gen,
+  const uint16_t iterations
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Returns the number of times the serial port serving the direction given was reopened, so a watcher of its file
+ *        descriptor knows when to move to the new one.
+ * 
+ * @param[in] dir Indication of the flow of information.
+ * @param[in] controller The controller object.
+ *
+ * @return The number of reopens, 0 if no serial port serves that direction.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+uint32_t mixlink_controller_gen(
+  const enum direction dir,
+  mixlink_controller_t * controller
+);
+
 /**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
  * @brief Calls the dynamic function to change information to be sent or received through the serial port. 
  * 
@@ -147,7 +213,36 @@ size_t mixlink_controller_read(
  * 
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 int8_t mixlink_controller_driver_io(
-  mixlink_abi_gen_io_t data,
+  mixlink_abi_gen_io_t * data,
+  const enum direction dir, 
+  mixlink_controller_t * controller
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Selects the serial port handler used by the pipeline for the direction given. 
+ * 
+ * @param[in] dir Indication of the flow of information.
+ * @param[in] controller The controller object.
+ *
+ * @return The handler of the duplex serial port if enabled, otherwise the handler of the simplex port for `dir`. \n
+ *         NULL if no serial port serves that direction.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+struct serial_handler * mixlink_controller_driver_pipeline_handler(
+  const enum direction dir, 
+  mixlink_controller_t * controller
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Returns the file descriptor of the serial port serving the direction given, used to wait for I/O readiness. 
+ * 
+ * @param[in] dir Indication of the flow of information.
+ * @param[in] controller The controller object.
+ *
+ * @return The file descriptor, or -1 if no serial port serves that direction.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int mixlink_controller_fd(
   const enum direction dir, 
   mixlink_controller_t * controller
 );
@@ -158,8 +253,13 @@ int8_t mixlink_controller_driver_io(
 
 #define MIXLINK_CONTROLLER_MODULES \
   X(framer)                        \
+  X(sched)                         \
   X(segm)                          \
-  X(qos)                                     
+  X(agg)                           \
+  X(qos)                           \
+  X(fec)                           \
+  X(check)                         \
+  X(mac)
 
 #define X(name) \
   MIXLINK_GEN_DEF_MODULES_DECL( controller, name, init  , mixlink_controller_t ) \
@@ -169,7 +269,8 @@ MIXLINK_CONTROLLER_MODULES
 #undef X
 
 #define X(name) \
-  MIXLINK_GEN_IO_MODULES_DECL(controller, name, io, mixlink_controller_t)
+  MIXLINK_GEN_IO_MODULES_DECL(controller, name, io, mixlink_controller_t) \
+  MIXLINK_GEN_IO_MODULES_DECL(controller, name, batch, mixlink_controller_t)
 MIXLINK_CONTROLLER_MODULES
 #undef X
 
@@ -0,0 +1,106 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      crc.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     CRC32C and CRC16 checksums, with the CRC instructions of the CPU selected at runtime.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: RFC 3720 appendix B.4 (CRC32C), ITU-T V.41 (CRC16).
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef CRC_H
+#define CRC_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_CRC32C_LEN 4                                                   //!< Bytes of the CRC32C trailer, little endian
+#define MIXLINK_CRC16_LEN  2                                                   //!< Bytes of the CRC16 trailer, little endian
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief CRC32C (Castagnoli), with SSE4.2 or the ARMv8 CRC extension when available, slice-by-8 tables otherwise.
+ *
+ * @param[in] src The data.
+ * @param[in] len The number of bytes of `src`.
+ *
+ * @return The checksum, 0xE3069283 for "123456789".
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+uint32_t mixlink_crc32c(
+  const uint8_t * src,
+  const size_t len
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief CRC-16/CCITT-FALSE, polynomial 0x1021 and initial value 0xFFFF, with a byte table.
+ *
+ * @param[in] src The data.
+ * @param[in] len The number of bytes of `src`.
+ *
+ * @return The checksum, 0x29B1 for "123456789".
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+uint16_t mixlink_crc16(
+  const uint8_t * src,
+  const size_t len
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Name of the CRC32C implementation picked for this CPU, e.g., "sse4.2".
+ *
+ * @return The name.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+const char * mixlink_crc_impl(
+  void
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,73 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      eth.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Wire format and limits of the Ethernet header elision of the `builtin:eth` mac stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: IEEE 802.3 clause 3 (MAC frame format).
+ *
+ *            A frame starts with its type, a context identifier below `MIXLINK_ETH_CONTEXTS` followed by the low byte of the
+ *            CRC32C of the header elided and the frame without it, `MIXLINK_ETH_IR` followed by the identifier and the whole frame to set up a context, or
+ *            `MIXLINK_ETH_RAW` followed by a frame too short to hold a header. A context is a destination, a source and an
+ *            ethertype, so a point-to-point link needs a handful of them.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef ETH_H
+#define ETH_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_ETH_HDR          14                                            //!< Destination, source and ethertype
+#define MIXLINK_ETH_CONTEXTS     16                                            //!< Headers remembered at once, the least recently used one is replaced
+#define MIXLINK_ETH_REFRESH      64                                            //!< Elided headers between two refreshes of a context, so a receiver that lost one resynchronizes
+
+#define MIXLINK_ETH_ELIDED       2                                             //!< Bytes in place of an elided header, the identifier and the check
+#define MIXLINK_ETH_IR           0xFD                                          //!< Sets up the context given in the next byte
+#define MIXLINK_ETH_RAW          0xFE                                          //!< The frame follows as is
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,124 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      fec.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     GF(256) arithmetic and the systematic Reed-Solomon erasure code of the `builtin:rs` stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: L. Rizzo, "Effective Erasure Codes for Reliable Computer Communication Protocols", ACM CCR, 1997.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef FEC_H
+#define FEC_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_FEC_MAX_K        32                                            //!< Most source segments in a block, argument `k`
+#define MIXLINK_FEC_MAX_M        16                                            //!< Most repair segments in a block, argument `m`
+#define MIXLINK_FEC_MAX_SYMBOL   512                                           //!< Longest segment protected, longer ones are sent without protection
+#define MIXLINK_FEC_HDR          4                                             //!< Block, index, sources and repairs of the block, the last two are 0 for a source segment
+#define MIXLINK_FEC_UNPROTECTED  0xFF                                          //!< Index of a segment outside any block
+#define MIXLINK_FEC_HOLD_MS      200                                           //!< Default wait before the repairs of an incomplete block are sent, argument `hold`
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Product of two elements of GF(256), polynomial 0x11D.
+ *
+ * @param[in] a The first factor.
+ * @param[in] b The second factor.
+ *
+ * @return The product.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+uint8_t mixlink_gf_mul(
+  const uint8_t a,
+  const uint8_t b
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Multiplicative inverse in GF(256).
+ *
+ * @param[in] a A non-zero element.
+ *
+ * @return The inverse, 0 for 0.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+uint8_t mixlink_gf_inv(
+  const uint8_t a
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Adds `c` times `src` to `dst`, byte by byte in GF(256), 16 bytes at a time with SSSE3 or NEON table lookups when available.
+ *
+ * @param[in,out] dst The accumulator.
+ * @param[in] src The region multiplied.
+ * @param[in] c The coefficient.
+ * @param[in] len The number of bytes of both regions.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_gf_madd(
+  uint8_t * dst,
+  const uint8_t * src,
+  const uint8_t c,
+  const size_t len
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Name of the region multiplication picked for this CPU, e.g., "ssse3".
+ *
+ * @return The name.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+const char * mixlink_fec_impl(
+  void
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
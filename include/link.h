@@ -0,0 +1,126 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      link.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Policy engine that retunes the redundancy of the FEC and the window of the ARQ from the loss measured on the serial link.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef LINK_H
+#define LINK_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mixlinkabi.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_LINK_PERIOD_MS    4000                                         //!< Interval between two runs of the policy
+#define MIXLINK_LINK_MIN_SAMPLES  32                                           //!< Segments a period needs before its loss replaces the estimate
+#define MIXLINK_LINK_TARGET_PPM   10000                                        //!< Highest share of FEC blocks the policy leaves to the ARQ, in parts per million
+#define MIXLINK_LINK_DEFAULT_K    8                                            //!< Block assumed until an adaptive encoder publishes its own
+#define MIXLINK_LINK_MAX_M        16                                           //!< Most repair segments the policy asks for
+#define MIXLINK_LINK_WINDOW_MIN   2                                            //!< Smallest ARQ window
+#define MIXLINK_LINK_WINDOW_MAX   64                                           //!< Largest ARQ window, also the initial one
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< State of the policy, only touched by the thread running it
+typedef struct{
+  uint64_t seen;                                                               //!< `rx_seen` of the link at the last run
+  uint64_t lost;
+  uint64_t bursts;
+  uint64_t good;
+  uint64_t bad;
+  uint32_t peer_epoch;                                                         //!< `peer_epoch` of the link at the last run
+  bool primed;                                                                 //!< The estimates hold at least one sample
+  double loss;                                                                 //!< Smoothed share of segments lost
+  double burst;                                                                //!< Smoothed mean length of a run of lost segments
+} mixlink_link_policy_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Resets the policy and publishes the initial choices in the link, no redundancy and the largest window.
+ *
+ * @param[out] policy The policy object.
+ * @param[in,out] link The counters of the serial link.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ *  - `EINVAL`: Invalid argument \n
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_link_policy_init(
+  mixlink_link_policy_t * policy,
+  mixlink_abi_link_t * link
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Folds the losses counted since the last run into the estimates and publishes new choices in the link.
+ *
+ * A report of the peer, about the frames this side sent, takes the place of the local measurement, otherwise the channel is
+ * assumed symmetric and the loss seen by the receiver is used. The repairs per block are the fewest that keep the share of
+ * blocks the FEC cannot rebuild under `MIXLINK_LINK_TARGET_PPM`, they rise at once and fall one per run. The ARQ window
+ * grows additively while the target is met and is halved otherwise.
+ *
+ * @param[in,out] policy The policy object.
+ * @param[in,out] link The counters of the serial link.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_link_policy_run(
+  mixlink_link_policy_t * policy,
+  mixlink_abi_link_t * link
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,76 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      lz.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Wire format and limits of the dictionary payload compressor of the `builtin:lz` comp stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: LZ4 block format description, Zstandard dictionary format (RFC 8878 section 5, raw content).
+ *
+ *            A frame starts with its type, `MIXLINK_LZ_RAW` followed by the frame as is, or `MIXLINK_LZ_BLOCK` with the low
+ *            bits of the CRC32C of the dictionary followed by a block of sequences. A sequence is a token, whose high nibble
+ *            is the number of literals and low nibble the match length minus `MIXLINK_LZ_MIN_MATCH`, 15 meaning that bytes
+ *            of 255 and a last byte below it follow, the literals, and the little endian distance of the match back into
+ *            the dictionary and the frame decoded so far. The last sequence stops after its literals.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef LZ_H
+#define LZ_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_LZ_RAW           0x00                                          //!< The frame follows as is
+#define MIXLINK_LZ_BLOCK         0x80                                          //!< Ored with the low 7 bits of the CRC32C of the dictionary, so peers with different ones notice
+
+#define MIXLINK_LZ_MIN_MATCH     4
+#define MIXLINK_LZ_HASH_LOG      12                                            //!< Entries of the match finder, a power of two
+#define MIXLINK_LZ_DICT_MAX      32768                                         //!< Bytes kept from the end of the dictionary file, a match reaches at most 65535 bytes back
+#define MIXLINK_LZ_MIN           64                                            //!< Default shortest frame compressed, argument `min`
+#define MIXLINK_LZ_BUDGET_US     1000                                          //!< Default time a frame may spend in the compressor, argument `budget`
+#define MIXLINK_LZ_PROBE         16                                            //!< Frames between two attempts while compression does not pay off
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -34,6 +34,7 @@
 #include <linux/limits.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <pthread.h>
 
 #include "mixlinkabi.h"
 
@@ -63,6 +64,12 @@ typedef struct{
   mixlink_callback_t rx;
   mixlink_callback_t tx;
   mixlink_callback_t deinit;
+  mixlink_abi_def_t def;                                                       //!< Argument of init, deinit and loop, lets the module schedule its own loop
+  uint32_t version;                                                            //!< Value of `<prefix>_abi_version`, 1 if the module does not export it
+  mixlink_callback_t rx_batch;                                                 //!< Only resolved for version 2 or above
+  mixlink_callback_t tx_batch;                                                 //!< Only resolved for version 2 or above
+  char args[NAME_MAX];                                                         //!< The text after '?' in the path, `def.args` points here
+  pthread_mutex_t * lock;                                                      //!< Shared by the modules loaded from the same library, held around each call unless the module sets `MIXLINK_CAP_THREADS`, NULL for built-in modules
 } mixlink_module_t;
 
 //!< Device identification if it is a NIC it is only represented by its name. If it is a serial port it uses the 3 parameters.
@@ -82,9 +89,14 @@ typedef struct{
     mixlink_param_dev_t def;                                                   //!< Indicate a duplex path from the translator pipeline to the serial port specified
   } dev;
 
+  char sched[NAME_MAX];                                                        //!< The scheduler of the frames from the NIC, ahead of every other TX stage, e.g., builtin:prio?ports=22:1
   char qos[NAME_MAX];                                                          //!< The Quality of Service (QoS) dynamic library path, e.g., libslidewindow.so
-  char framer[NAME_MAX];                                                       //!< The Framer L1 dynamic library path, e.g., libcobs.so, it can be the same the translator
+  char framer[NAME_MAX];                                                       //!< The Framer L1 dynamic library path, e.g., libcobs.so or builtin:cobs, it can be the same the translator
   char segm[NAME_MAX];                                                         //!< The Segmenter used for L1.
+  char agg[NAME_MAX];                                                          //!< The Aggregation of small frames into one packet between the segmenter and the QoS, e.g., builtin:agg?max=255&hold=20
+  char fec[NAME_MAX];                                                          //!< The Forward Error Correction (FEC) between the QoS and the integrity check, e.g., builtin:rs?k=8&m=2
+  char mac[NAME_MAX];                                                          //!< The turn-taking of the half-duplex channel between the FEC and the integrity check, e.g., builtin:tdma?mode=token&id=0&weights=2,1
+  char check[NAME_MAX];                                                        //!< The integrity check between the QoS and the framer, e.g., builtin:crc32c, corrupted frames are dropped before the QoS
 } mixlink_param_controller_t;
 
 //!< Translator application, dynamic libraries path.
@@ -97,8 +109,16 @@ typedef struct{
     mixlink_param_dev_t def;                                                   //!< Indicate a duplex path from the controller pipeline to the NIC specified
   } nic;
 
+  char mac[NAME_MAX];                                                          //!< The link header elision next to the NIC, e.g., builtin:eth, it runs before the opt on transmission
   char opt[NAME_MAX];                                                          //!< The overhead Optimizer (opt) dynamic library path, e.g., libtcpopt.so
+  char comp[NAME_MAX];                                                         //!< The payload Compressor (comp) between the opt and the framer, e.g., builtin:lz?dict=/etc/mixlink/mqtt.dict
   char framer[NAME_MAX];                                                       //!< The Framer L2 dynamic library path, e.g., libcbos.so, it can be the same the controller
+  char backend[NAME_MAX];                                                      //!< "socket" (default) binds to existing NICs, "tun" or "tap" creates the device named in `nic.def`
+  char mmap[NAME_MAX];                                                         //!< "true" maps PACKET_MMAP rings on the NIC sockets, frames are then exchanged without a syscall each
+  struct{
+    char drop[NAME_MAX];                                                       //!< Comma separated traffic dropped by the kernel, e.g., "ipv6,nd,mdns,llmnr,stp,lldp"
+    char program[NAME_MAX];                                                    //!< Path to a classic BPF program in the `tcpdump -ddd` format, used instead of `drop`
+  } filter;                                                                    //!< Socket filter of the NIC, outgoing frames are always dropped
 } mixlink_param_translator_t;
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -136,13 +156,16 @@ enum direction{
     strerror(errno)                                             \
   )  
 
+#define MIXLINK_MODULE_MAX_LIBS 32                                             //!< Shared libraries loaded at once, each with the lock that serializes its calls
+
 #define MIXLINK_DEF_SUFFIXES \
   X(init)                  \
   X(deinit)                \
   X(loop)
 
 #define MIXLINK_IO_SUFFIXES \
-  X(io)  
+  X(io)                    \
+  X(batch)
 
 #define MIXLINK_GEN_DEF_MODULES_DECL(prefix, name, suffix, type ) \
   int8_t mixlink_##prefix##_##name##_##suffix( \
@@ -151,7 +174,7 @@ enum direction{
 
 #define MIXLINK_GEN_IO_MODULES_DECL(prefix, name, suffix, type ) \
   int8_t mixlink_##prefix##_##name##_##suffix(   \
-    mixlink_abi_gen_io_t abi,                    \
+    mixlink_abi_gen_io_t * abi,                  \
     enum direction dir,                          \
     const type * self                            \
   );
@@ -165,8 +188,9 @@ enum direction{
       errno = EINVAL;                            \
       return -1;                                 \
     }                                            \
-    return mixlink_mod_exec(                     \
-      NULL,                                      \
+    return mixlink_mod_call(                     \
+      (void *) &self->name.def,                  \
+      &self->name,                               \
       &self->name.suffix                         \
     );                                           \
   }
@@ -174,16 +198,34 @@ enum direction{
 #define MIXLINK_GEN_IO_MODULES_IMPL( prefix, name, suffix, type ) \
   int8_t                                         \
   mixlink_##prefix##_##name##_##suffix(          \
-    mixlink_abi_gen_io_t abi,                    \
+    mixlink_abi_gen_io_t * abi,                  \
     enum direction dir,                          \
     const type * self                            \
   ){                                             \
-    if( !self ){                                 \
+    if( !self || !abi ){                         \
       errno = EINVAL;                            \
       return -1;                                 \
     }                                            \
     return mixlink_mod_exec_io(                  \
-      (void*) &abi,                              \
+      (void*) abi,                               \
+      dir,                                       \
+      &self->name                                \
+    );                                           \
+  }
+
+#define MIXLINK_GEN_BATCH_MODULES_IMPL( prefix, name, suffix, type ) \
+  int8_t                                         \
+  mixlink_##prefix##_##name##_##suffix(          \
+    mixlink_abi_gen_io_t * abi,                  \
+    enum direction dir,                          \
+    const type * self                            \
+  ){                                             \
+    if( !self || !abi ){                         \
+      errno = EINVAL;                            \
+      return -1;                                 \
+    }                                            \
+    return mixlink_mod_exec_batch(               \
+      abi,                                       \
       dir,                                       \
       &self->name                                \
     );                                           \
@@ -197,7 +239,7 @@ enum direction{
 /**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
  * @brief Tries to load the callback interface for a module indicated in `path`. 
  * 
- * @param[in] path The path to the desired module, e.g., libcobs.so
+ * @param[in] path The path to the desired module, e.g., libcobs.so, or a built-in module, e.g., builtin:cobs, optionally followed by '?' and its arguments, e.g., builtin:rs?k=8&m=2
  * @param[in] section Indicates the stack module to load.
  * @param[out] module The structure that will be filled with the loaded callback functions.
  *
@@ -250,6 +292,26 @@ int8_t mixlink_mod_exec(
   const mixlink_callback_t * cb
 );
 
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Executes an interface function of a module, serialized with the other calls into its library. 
+ * 
+ * Modules loaded from a shared library were written for a single thread, the TX, RX and main threads take the lock of the
+ * library before calling them, unless the module set `MIXLINK_CAP_THREADS` in `caps` during init. Built-in modules are called
+ * directly.
+ * 
+ * @param[in] arg  Pointer to an argument structure containing the data required by the module.
+ * @param[in] mod The module the callback belongs to.
+ * @param[in] cb Pointer to the callback function representing the module interface.
+ *
+ * @return The value of `mixlink_mod_exec()`.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_mod_call(
+  void * arg,
+  const mixlink_module_t * mod,
+  const mixlink_callback_t * cb
+);
+
 /**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
  * @brief Calls the correct pipeline dynamic function from the loaded module, if present on the stack. 
  * 
@@ -267,6 +329,54 @@ int8_t mixlink_mod_exec_io(
   const mixlink_module_t * mod
 );
 
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Indicates if the module implements the pipeline dynamic function for the direction given. 
+ * 
+ * @param[in] mod The module to check.
+ * @param[in] dir Indication of the flow of information.
+ *
+ * @return True if the module has a single buffer or a batch function for the direction, false if the stage should be bypassed.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+bool mixlink_mod_io_enabled(
+  const mixlink_module_t * mod,
+  const enum direction dir
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Processes several independent buffers with one call into the module. 
+ * 
+ * Modules of ABI version 2 receive the whole batch through `<prefix>_rx_batch` or `<prefix>_tx_batch`.
+ * Older modules are adapted, the single buffer function is called once per input and the outputs are packed in order.
+ * 
+ * @param[in,out] abi `in[0..n_in)` are the buffers, on return `n_in` is the number consumed and `out[0..n_out)` the outputs.
+ * @param[in] dir Indication of the flow of information.
+ * @param[in] mod The module to execute.
+ *
+ * @return Upon success, it returns 0 and the outputs are valid, or 1 if the consumed inputs were absorbed without outputs. \n 
+ *         Otherwise -1 is returned, every input is dropped and errno is set. 
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_mod_exec_batch(
+  mixlink_abi_gen_io_t * abi,
+  const enum direction dir, 
+  const mixlink_module_t * mod
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Indicates if the module has a native batch function for the direction given. 
+ * 
+ * @param[in] mod The module to check.
+ * @param[in] dir Indication of the flow of information.
+ *
+ * @return True if `mixlink_mod_exec_batch()` calls the module once per batch, false if it goes through the adapter.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+bool mixlink_mod_batch_enabled(
+  const mixlink_module_t * mod,
+  const enum direction dir
+);
+
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * External C++ extern macro
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
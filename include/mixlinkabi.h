@@ -34,6 +34,8 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 #include <xcserial.h>
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -49,10 +51,21 @@ extern "C" {
  * New types
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
+#define MIXLINK_BUF_MAX_FRAGS    4                                             //!< Slices that can follow the data of a buffer
+
+//!< Slice of memory that continues the data of a buffer, it is not owned by the buffer
+typedef struct{
+  uint8_t * val;
+  size_t len;
+} mixlink_frag8_t;
+
 typedef struct{
   uint8_t * val;                                                               //!< Values stored on the buffer, this requires initialization
   size_t len;                                                                  //!< The length of the data stored in `val` 
   size_t size;                                                                 //!< The total length of the memory region of `val`
+  size_t head;                                                                 //!< Bytes of the memory region before `val`, headers can be pushed there in place
+  mixlink_frag8_t frag[ MIXLINK_BUF_MAX_FRAGS ];                               //!< The data continues in these slices, in order, e.g., a payload referenced from an input buffer
+  uint8_t n_frag;                                                              //!< Number of slices in `frag`, 0 for a flat buffer
 } mixlink_buf8_t;
 
 typedef struct{
@@ -72,30 +85,389 @@ typedef struct{
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
 #define MIXLINK_MODULE_MAX_PORTS 16
+#define MIXLINK_ABI_VERSION      2                                             //!< Modules exporting `<prefix>_abi_version` at 2 or above may export `<prefix>_rx_batch` and `<prefix>_tx_batch`
+#define MIXLINK_BUF_HEADROOM     64                                            //!< Minimum `head` of the buffers given by the core to the modules
+#define MIXLINK_BUF_TAILROOM     64                                            //!< Bytes the core adds to `size` beyond its own payload limit, for trailers
+#define MIXLINK_CAP_FRAGS        (1u << 0)                                     //!< The module handles input buffers with `n_frag` above 0, otherwise the core flattens them first
+#define MIXLINK_CAP_THREADS      (1u << 1)                                     //!< The module may be called from the TX, RX and main threads at once, otherwise the core serializes the calls into its library
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * ABI buffer helpers
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Grows the data of the buffer `n` bytes to the front, using the headroom.
+ *
+ * @param[in,out] buf The buffer.
+ * @param[in] n The number of bytes of the header.
+ *
+ * @return The new start of the data, where the header is written, or NULL if the headroom is too small.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline uint8_t *
+mixlink_buf8_push(
+  mixlink_buf8_t * buf,
+  const size_t n
+){
+  if( buf->head < n )
+    return NULL;
+
+  buf->val  -= n;
+  buf->head -= n;
+  buf->len  += n;
+  buf->size += n;
+  return buf->val;
+}
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Removes `n` bytes from the front of the data, they become headroom.
+ *
+ * @param[in,out] buf The buffer.
+ * @param[in] n The number of bytes of the header.
+ *
+ * @return The removed header, or NULL if the data is shorter than `n`.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline uint8_t *
+mixlink_buf8_pull(
+  mixlink_buf8_t * buf,
+  const size_t n
+){
+  if( buf->len < n )
+    return NULL;
+
+  uint8_t * hdr = buf->val;
+  buf->val  += n;
+  buf->head += n;
+  buf->len  -= n;
+  buf->size -= n;
+  return hdr;
+}
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Grows the data of the buffer `n` bytes to the back, using the tailroom.
+ *
+ * @param[in,out] buf The buffer.
+ * @param[in] n The number of bytes of the trailer.
+ *
+ * @return The start of the trailer, or NULL if the tailroom is too small.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline uint8_t *
+mixlink_buf8_put(
+  mixlink_buf8_t * buf,
+  const size_t n
+){
+  if( buf->size - buf->len < n )
+    return NULL;
+
+  uint8_t * tail = &buf->val[ buf->len ];
+  buf->len += n;
+  return tail;
+}
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Removes `n` bytes from the back of the data.
+ *
+ * @param[in,out] buf The buffer.
+ * @param[in] n The number of bytes of the trailer.
+ *
+ * @return The removed trailer, or NULL if the data is shorter than `n`.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline uint8_t *
+mixlink_buf8_trim(
+  mixlink_buf8_t * buf,
+  const size_t n
+){
+  if( buf->len < n )
+    return NULL;
+
+  buf->len -= n;
+  return &buf->val[ buf->len ];
+}
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Appends a slice to the data of the buffer, without copying it.
+ *
+ * The slice may reference an `in` buffer of the same IO call, the core keeps it valid until the buffer is consumed.
+ *
+ * @param[in,out] buf The buffer.
+ * @param[in] val The start of the slice.
+ * @param[in] len The number of bytes of the slice.
+ *
+ * @return 0 on success, or -1 if the buffer already has `MIXLINK_BUF_MAX_FRAGS` slices.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline int8_t
+mixlink_buf8_link(
+  mixlink_buf8_t * buf,
+  uint8_t * val,
+  const size_t len
+){
+  if( MIXLINK_BUF_MAX_FRAGS <= buf->n_frag )
+    return -1;
+
+  buf->frag[ buf->n_frag ].val = val;
+  buf->frag[ buf->n_frag ].len = len;
+  buf->n_frag ++;
+  return 0;
+}
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Length of the whole data of the buffer, slices included.
+ *
+ * @param[in] buf The buffer.
+ *
+ * @return The number of bytes.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline size_t
+mixlink_buf8_total(
+  const mixlink_buf8_t * buf
+){
+  size_t len = buf->len;
+  for( uint8_t i = 0 ; i < buf->n_frag ; ++i )
+    len += buf->frag[i].len;
+  return len;
+}
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Copies the slices after the data at `val`, leaving a flat buffer.
+ *
+ * @param[in,out] buf The buffer.
+ *
+ * @return 0 on success, or -1 if the tailroom is too small, the buffer is left untouched.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline int8_t
+mixlink_buf8_flatten(
+  mixlink_buf8_t * buf
+){
+  if( buf->size < mixlink_buf8_total( buf ) )
+    return -1;
+
+  for( uint8_t i = 0 ; i < buf->n_frag ; ++i ){
+    (void) memmove( &buf->val[ buf->len ], buf->frag[i].val, buf->frag[i].len );
+    buf->len += buf->frag[i].len;
+  }
+
+  buf->n_frag = 0;
+  return 0;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * ABI argument helpers
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Reads a numeric argument given to the module after its path, e.g., "builtin:rs?k=8&m=2".
+ *
+ * @param[in] args The `args` of `mixlink_abi_def_t`, e.g., "k=8&m=2", it may be NULL.
+ * @param[in] key The name of the argument, e.g., "k".
+ * @param[in] def The value used when the argument is missing or not a number.
+ *
+ * @return The value of the argument.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline long
+mixlink_abi_arg(
+  const char * args,
+  const char * key,
+  const long def
+){
+  const size_t klen = strlen( key );
+
+  for( const char * at = args ; at && *at ; at = strchr( at, '&' ), at = at ? at + 1 : NULL ){
+    if( strncmp( at, key, klen ) || '=' != at[ klen ] )
+      continue;
+
+    char * end;
+    const long val = strtol( &at[ klen + 1 ], &end, 0 );
+    return ( end == &at[ klen + 1 ] ) ? def : val;
+  }
+
+  return def;
+}
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Reads a text argument given to the module after its path, e.g., "builtin:lz?dict=/etc/mixlink/mqtt.dict".
+ *
+ * @param[in] args The `args` of `mixlink_abi_def_t`, it may be NULL.
+ * @param[in] key The name of the argument, e.g., "dict".
+ * @param[out] buf Where the value is copied, up to the next '&'.
+ * @param[in] size The bytes of `buf`.
+ *
+ * @return `buf`, or NULL if the argument is missing or does not fit.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline char *
+mixlink_abi_arg_str(
+  const char * args,
+  const char * key,
+  char * buf,
+  const size_t size
+){
+  const size_t klen = strlen( key );
+
+  for( const char * at = args ; at && *at ; at = strchr( at, '&' ), at = at ? at + 1 : NULL ){
+    if( strncmp( at, key, klen ) || '=' != at[ klen ] )
+      continue;
+
+    const char * val = &at[ klen + 1 ];
+    const char * end = strchr( val, '&' );
+    const size_t len = end ? (size_t) ( end - val ) : strlen( val );
+    if( len >= size )
+      return NULL;
+
+    (void) memcpy( buf, val, len );
+    buf[ len ] = '\0';
+    return buf;
+  }
+
+  return NULL;
+}
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * ABI data structures
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
-//!< Generic Interface for IO
+//!< Asks the core to call the module back once after `ms` milliseconds, 0 as soon as possible, it is safe to call from any thread
+typedef int8_t (* mixlink_abi_schedule_fn_t)( 
+  void * ctx, 
+  const uint32_t ms 
+);
+
+//!< Counters of the serial link, kept by the core and shared by every stage, updated with relaxed atomics as they cross threads
+typedef struct {
+  uint64_t rx_good;                                                            //!< Frames received that passed the integrity check
+  uint64_t rx_bad;                                                             //!< Frames received that were dropped by the integrity check
+  uint64_t rx_seen;                                                            //!< Segments the receiver knows were sent, arrived or not, e.g., the positions of a FEC block
+  uint64_t rx_lost;                                                            //!< Segments of `rx_seen` that never arrived
+  uint64_t rx_bursts;                                                          //!< Runs of consecutive segments in `rx_lost`
+  uint64_t rx_recovered;                                                       //!< Segments of `rx_lost` rebuilt by the FEC
+  uint32_t peer_loss;                                                          //!< Share of the frames sent that the peer lost, in parts per million, from its QoS feedback
+  uint32_t peer_burst;                                                         //!< Mean length of the runs of frames the peer lost, in hundredths
+  uint32_t peer_epoch;                                                         //!< Incremented with every report of the peer
+  uint32_t loss;                                                               //!< Loss estimated by the policy, in parts per million
+  uint32_t burst;                                                              //!< Mean burst length estimated by the policy, in hundredths
+  uint32_t epoch;                                                              //!< Incremented every time the policy publishes its choices
+  uint8_t fec_k;                                                               //!< Source segments per block of an adaptive FEC encoder, published by the encoder
+  uint8_t fec_m;                                                               //!< Repair segments per block chosen by the policy, read by adaptive FEC encoders
+  uint16_t arq_window;                                                         //!< Segments in flight chosen by the policy, read by ARQ stages
+} mixlink_abi_link_t;
+
+//!< Generic Interface for IO, in a batch call `in` holds independent buffers and the module sets `n_in` to the number it consumed
 typedef struct { 
   mixlink_buf8_t * in[MIXLINK_MODULE_MAX_PORTS];
   uint8_t n_in;
-  mixlink_buf8_t * out[MIXLINK_MODULE_MAX_PORTS];
-  uint8_t n_out;
+  mixlink_buf8_t * out[MIXLINK_MODULE_MAX_PORTS];                              //!< Empty buffers given by the core, the module fills them in order
+  uint8_t n_out;                                                               //!< Number of buffers in `out`, the module sets it to the number of buffers filled
+  mixlink_abi_schedule_fn_t wake;                                              //!< Calls this IO function again after `ms`, with `n_in` set to 0, e.g., for retransmission deadlines
+  void * wake_ctx;                                                             //!< First argument of `wake`
+  void * priv;                                                                 //!< The `priv` the module set in `mixlink_abi_def_t` during init, e.g., the state of a deframer
+  mixlink_abi_link_t * link;                                                   //!< The serial link the stage belongs to
+  mixlink_abi_schedule_fn_t wake_reverse;                                      //!< As `wake`, for the IO function of the same module in the other direction, e.g., to send an acknowledgement
+  void * wake_reverse_ctx;                                                     //!< First argument of `wake_reverse`
+  uint32_t backlog;                                                            //!< Buffers queued after the stage that the sink has not taken yet, in TX the frames waiting for the serial port
+  bool drain;                                                                  //!< Set by the module to be called again with `n_in` set to 0 once the sink has taken a buffer, e.g., to release a held frame
+  uint32_t held;                                                               //!< Set by the module to the buffers it keeps to send later, e.g., until its turn to transmit, counted in the `backlog` of the stages before it
+  bool full;                                                                   //!< Set by the module when it cannot keep another buffer, the core leaves the next ones in its input ring until a call with `n_in` set to 0 clears it
 } mixlink_abi_gen_io_t;
 
+//!< Used for default dynamic functions of the stack modules such as: init, deinit and loop
+typedef struct {
+  mixlink_abi_schedule_fn_t schedule;                                          //!< Calls the `loop` function of the module after `ms`, e.g., for keepalive deadlines
+  void * ctx;                                                                  //!< First argument of `schedule`
+  uint32_t caps;                                                               //!< Set by the module during init, e.g., `MIXLINK_CAP_FRAGS`
+  void * priv;                                                                 //!< Set by the module during init, its own state for this instance, released by the module in deinit
+  const char * args;                                                           //!< The text after '?' in the module path, read with `mixlink_abi_arg()`, empty if none
+} mixlink_abi_def_t;
+
+//!< Modulation of the transceiver behind the serial port, filled by its driver during init, zero where unknown
+typedef struct {
+  uint8_t sf;                                                                  //!< LoRa spreading factor, 6 to 12, 0 if the transceiver is not LoRa
+  uint8_t cr;                                                                  //!< Coding rate denominator, 5 to 8 for 4/5 to 4/8
+  uint16_t preamble;                                                           //!< Preamble symbols, 8 if 0
+  uint32_t bw;                                                                 //!< Bandwidth in Hz, e.g., 125000
+  bool crc;                                                                    //!< The packets carry a payload CRC
+  bool implicit;                                                               //!< The packets carry no header
+  uint16_t payload;                                                            //!< Longest packet the transceiver sends, longer writes are split, e.g., 240 for the E22 modules
+  uint16_t duty;                                                               //!< Regulatory duty cycle of the channel in parts per thousand, e.g., 10 for the 1 % of most EU868 sub-bands, 0 for none
+  uint16_t buffer;                                                             //!< Bytes the transceiver holds from the serial port before it drops, e.g., 1000 for the E22 modules
+  uint32_t rate;                                                               //!< Bytes per second the transceiver sends, 0 to derive it from the modulation
+} mixlink_abi_radio_t;
+
+//!< Tells whether the transceiver takes more data now, e.g., from its AUX pin, it is called by the TX thread before each write
+typedef bool (* mixlink_abi_ready_fn_t)( 
+  void * ctx 
+);
+
 //!< Used for default dynamic functions associated with the driver such as: init, deinit and loop
 typedef struct {
   serial_t * sr;
+  mixlink_abi_def_t def;
+  mixlink_abi_radio_t * radio;                                                 //!< Filled by the driver during init if it knows the modulation, the driver arguments of the same names override it
 } mixlink_abi_def_serial_t;
 
 //!< Used for IO dynamic functions associated with the driver such as: io
 typedef struct {
-  serial_t             * sr;
-  mixlink_abi_gen_io_t * data;
+  serial_t               * sr;
+  mixlink_abi_gen_io_t   * data;
+  mixlink_abi_ready_fn_t   ready;                                              //!< Set by the driver in TX to gate the writes on the state of the transceiver, kept by the core until replaced, NULL to rely on CTS if the argument `cts` is set
+  void                   * ready_ctx;                                          //!< First argument of `ready`
 } mixlink_abi_io_serial_t;
 
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * ABI link helpers
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Counts segments a receiving stage expected, e.g., the positions of a closed FEC block, for the policy.
+ *
+ * @param[in,out] link The `link` of the IO call, it may be NULL.
+ * @param[in] seen The number of segments expected.
+ * @param[in] lost How many of them never arrived.
+ * @param[in] bursts The number of runs of consecutive lost segments.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline void
+mixlink_abi_link_observe(
+  mixlink_abi_link_t * link,
+  const uint64_t seen,
+  const uint64_t lost,
+  const uint64_t bursts
+){
+  if( !link )
+    return;
+
+  __atomic_fetch_add( &link->rx_seen, seen, __ATOMIC_RELAXED );
+  __atomic_fetch_add( &link->rx_lost, lost, __ATOMIC_RELAXED );
+  __atomic_fetch_add( &link->rx_bursts, bursts, __ATOMIC_RELAXED );
+}
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Hands a loss report of the peer, about the frames this side sent, to the policy, e.g., from a QoS feedback message.
+ *
+ * @param[in,out] link The `link` of the IO call, it may be NULL.
+ * @param[in] loss The share of frames lost, in parts per million.
+ * @param[in] burst The mean length of the runs of lost frames, in hundredths.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+static inline void
+mixlink_abi_link_peer(
+  mixlink_abi_link_t * link,
+  const uint32_t loss,
+  const uint32_t burst
+){
+  if( !link )
+    return;
+
+  __atomic_store_n( &link->peer_loss, loss, __ATOMIC_RELAXED );
+  __atomic_store_n( &link->peer_burst, burst, __ATOMIC_RELAXED );
+  __atomic_fetch_add( &link->peer_epoch, 1, __ATOMIC_RELEASE );
+}
+
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * Sections Macros
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -104,10 +476,17 @@ typedef struct {
 #define MIXLINK_STACK_SECTION_CONTROLLER_QOS     "mod_mixlink_controller_qos"
 #define MIXLINK_STACK_SECTION_CONTROLLER_SEGM    "mod_mixlink_controller_segm"
 #define MIXLINK_STACK_SECTION_CONTROLLER_FRAMER  "mod_mixlink_controller_framer"
+#define MIXLINK_STACK_SECTION_CONTROLLER_CHECK   "mod_mixlink_controller_check"
+#define MIXLINK_STACK_SECTION_CONTROLLER_AGG     "mod_mixlink_controller_agg"
+#define MIXLINK_STACK_SECTION_CONTROLLER_SCHED   "mod_mixlink_controller_sched"
+#define MIXLINK_STACK_SECTION_CONTROLLER_FEC     "mod_mixlink_controller_fec"
+#define MIXLINK_STACK_SECTION_CONTROLLER_MAC     "mod_mixlink_controller_mac"
 #define MIXLINK_STACK_SECTION_CONTROLLER_DRIVER  "mod_mixlink_controller_driver"
 
 #define MIXLINK_STACK_SECTION_TRANSLATOR         "mod_mixlink_translator"
+#define MIXLINK_STACK_SECTION_TRANSLATOR_MAC     "mod_mixlink_translator_mac"
 #define MIXLINK_STACK_SECTION_TRANSLATOR_OPT     "mod_mixlink_translator_opt"
+#define MIXLINK_STACK_SECTION_TRANSLATOR_COMP    "mod_mixlink_translator_comp"
 #define MIXLINK_STACK_SECTION_TRANSLATOR_FRAMER  "mod_mixlink_translator_framer"
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -0,0 +1,204 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      pipeline.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Pipeline runtime, one thread per direction with rings between the stack stages.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "mixlink.h"
+#include "ring.h"
+#include "reactor.h"
+#include "translator.h"
+#include "controller.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_PIPELINE_MAX_STAGES 16                                         //!< Maximum number of stages in one direction
+#define MIXLINK_PIPELINE_RING_SLOTS 32                                         //!< Descriptors in each ring between stages, power of two
+#define MIXLINK_PIPELINE_BUFSIZE    4096                                       //!< Bytes available to each descriptor
+#define MIXLINK_PIPELINE_BURST      16                                         //!< Maximum descriptors a stage consumes before giving the turn to the next one
+#define MIXLINK_PIPELINE_REOPEN_MS  100                                        //!< First wait before reopening a serial port that hung up, doubled on each failure
+#define MIXLINK_PIPELINE_REOPEN_MAX_MS 5000
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Generic call into a stack stage
+typedef int8_t (* mixlink_stage_fn_t)(
+  mixlink_abi_gen_io_t * abi,
+  const enum direction dir,
+  void * obj
+);
+
+//!< A stage of the pipeline, reads descriptors from `ring[i]` and writes them to `ring[i + 1]`
+typedef struct{
+  const char * name;
+  mixlink_stage_fn_t fn;                                                       //!< The stack function, e.g., `mixlink_translator_opt_io`
+  mixlink_stage_fn_t batch;                                                    //!< The batch stack function, NULL unless the module exports a native batch function
+  void * obj;                                                                  //!< The translator or controller object
+  const mixlink_module_t * mod;                                                //!< The module behind the stage, if it has no IO for the direction the stage is bypassed
+  mixlink_event_t * timer;                                                     //!< Armed by the module through `mixlink_abi_gen_io_t.wake`
+  bool kick;                                                                   //!< The timer expired, the stage runs once with no input
+  mixlink_event_t * reverse;                                                   //!< The `timer` of the same stage in the other direction, armed through `wake_reverse`
+} mixlink_stage_t;
+
+//!< One direction of the pipeline, owned by a single thread
+struct mixlink_path{
+  enum direction dir;
+  mixlink_stage_t stage[ MIXLINK_PIPELINE_MAX_STAGES ];
+  mixlink_ring_t ring[ MIXLINK_PIPELINE_MAX_STAGES + 1 ];                      //!< `ring[0]` is filled by the source, `ring[nstages]` is drained by the sink
+  size_t done[ MIXLINK_PIPELINE_MAX_STAGES + 1 ];                              //!< Descriptors at the tail of `ring[i]` already consumed, released once no slice references them
+  uint8_t ref[ MIXLINK_PIPELINE_MAX_STAGES + 1 ][ MIXLINK_PIPELINE_RING_SLOTS ]; //!< Descriptors of `ring[i + 1]` whose slices may reference each slot of `ring[i]`
+  uint8_t src[ MIXLINK_PIPELINE_MAX_STAGES + 1 ][ MIXLINK_PIPELINE_RING_SLOTS ]; //!< Slot of `ring[i - 1]` referenced by each slot of `ring[i]` plus one, 0 for none
+  uint8_t nstages;
+  bool drain[ MIXLINK_PIPELINE_MAX_STAGES ];                                   //!< The stage asked through `mixlink_abi_gen_io_t.drain` to be kicked once the sink takes a buffer
+  uint32_t held[ MIXLINK_PIPELINE_MAX_STAGES ];                                //!< Buffers the stage reported in `mixlink_abi_gen_io_t.held` on its last call
+  bool full[ MIXLINK_PIPELINE_MAX_STAGES ];                                    //!< The stage reported `mixlink_abi_gen_io_t.full` on its last call and is only kicked until it clears it
+
+  mixlink_reactor_t reactor;                                                   //!< Only the source, the stage timers and the stop request wake the thread
+  mixlink_event_t * source;                                                    //!< The socket for TX, the serial port for RX
+  mixlink_event_t * policy;                                                    //!< Runs the link policy every `MIXLINK_LINK_PERIOD_MS`, TX only
+  mixlink_event_t * pace;                                                      //!< Wakes the thread once the airtime budget covers the next write, TX only
+  mixlink_event_t * revive;                                                    //!< Retries the reopen of the serial port while it is gone, RX only
+  uint32_t revive_ms;                                                          //!< Next wait of `revive`
+  uint32_t gen;                                                                //!< Reopens of the serial port when `source` was bound to it, RX only
+  bool lost;                                                                   //!< The serial port hung up and `source` watches nothing until it is reopened
+  bool readable;                                                               //!< The source reported data since the last read
+  bool paused;                                                                 //!< The source is not watched because `ring[0]` is full
+  bool mmap;                                                                   //!< The NIC side of the direction goes through the PACKET_MMAP ring of the translator
+
+  pthread_t thread;
+  bool started;
+  struct mixlink_pipeline * pipeline;
+};
+
+//!< Pipeline object, TX goes from the NIC to the serial port and RX from the serial port to the NIC
+typedef struct mixlink_pipeline{
+  mixlink_translator_t * translator;
+  mixlink_controller_t * controller;
+
+  struct mixlink_path tx;
+  struct mixlink_path rx;
+
+  bool running;                                                                //!< Cleared to request both threads to stop
+} mixlink_pipeline_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Builds the stages and allocates the rings for both directions of the pipeline.
+ *
+ * The TX direction runs controller sched, translator mac, translator opt, translator comp, translator framer, controller segm, controller agg, controller qos, controller fec, controller mac, controller check, controller framer and the driver.
+ * The RX direction runs the same stages in the reverse order. The TX thread also runs the link policy of the controller, and its
+ * sink holds the writes the airtime budget and the rate shaper of the controller cannot cover yet, or that the transceiver is
+ * not ready for.
+ *
+ * @param[out] pipeline The pipeline object to initialize.
+ * @param[in] translator An initialized translator object.
+ * @param[in] controller An initialized controller object.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ *  - `EINVAL`: Invalid argument \n
+ *  - `ENOMEM`: Not enough memory for the rings \n
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_pipeline_init(
+  mixlink_pipeline_t * pipeline,
+  mixlink_translator_t * translator,
+  mixlink_controller_t * controller
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Launches the TX and RX threads.
+ *
+ * @param[in,out] pipeline The pipeline object.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_pipeline_start(
+  mixlink_pipeline_t * pipeline
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Requests both threads to stop and waits for them.
+ *
+ * @param[in,out] pipeline The pipeline object.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_pipeline_stop(
+  mixlink_pipeline_t * pipeline
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the rings of both directions, the pipeline must be stopped.
+ *
+ * @param[in,out] pipeline The pipeline object.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_pipeline_close(
+  mixlink_pipeline_t * pipeline
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
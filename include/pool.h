@@ -0,0 +1,147 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      pool.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Preallocated pool of packet buffers with headroom and tailroom.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef POOL_H
+#define POOL_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/uio.h>
+
+#include "mixlinkabi.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_CACHE_LINE 64
+#define MIXLINK_BUF_MAX_IOV    ( MIXLINK_BUF_MAX_FRAGS + 1 )                   //!< Entries `mixlink_buf8_iov()` may fill
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Fixed number of buffers carved from a single cache-line-aligned region, never resized after `mixlink_pool_init()`
+typedef struct{
+  mixlink_buf8_t * buf;                                                        //!< Descriptors, `count` entries
+  size_t count;
+
+  uint8_t * mem;                                                               //!< Memory region backing the descriptors
+  size_t stride;                                                               //!< Bytes between two buffers, a multiple of the cache line
+  size_t headroom;                                                             //!< Bytes kept before `val` by `mixlink_pool_reset()`
+  size_t bufsize;                                                              //!< Bytes available from `val` after `mixlink_pool_reset()`, tailroom included
+} mixlink_pool_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates `count` buffers of `headroom + bufsize + tailroom` bytes, each one starting on its own cache line.
+ *
+ * @param[out] pool The pool to initialize.
+ * @param[in] count The number of buffers.
+ * @param[in] bufsize The payload capacity in bytes of each buffer.
+ * @param[in] headroom The bytes reserved before the payload, for headers pushed in place.
+ * @param[in] tailroom The bytes reserved after the payload, for trailers such as checksums.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ *  - `EINVAL`: Invalid argument \n
+ *  - `ENOMEM`: Not enough memory \n
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_pool_init(
+  mixlink_pool_t * pool,
+  const size_t count,
+  const size_t bufsize,
+  const size_t headroom,
+  const size_t tailroom
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the memory held by the pool, every buffer taken from it becomes invalid.
+ *
+ * @param[in,out] pool The pool to release.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_pool_free(
+  mixlink_pool_t * pool
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Empties a buffer of the pool and moves `val` back to the end of the headroom, undoing every push and pull.
+ *
+ * @param[in] pool The pool that owns `buf`.
+ * @param[in,out] buf The buffer.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_pool_reset(
+  const mixlink_pool_t * pool,
+  mixlink_buf8_t * buf
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Describes the data of a buffer and its slices as an `iovec` array, to be written with a single `writev()`.
+ *
+ * @param[in] buf The buffer.
+ * @param[out] iov At least `MIXLINK_BUF_MAX_IOV` entries.
+ *
+ * @return The number of entries filled.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+size_t mixlink_buf8_iov(
+  const mixlink_buf8_t * buf,
+  struct iovec * iov
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,82 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      prio.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Classes and limits of the strict priority and deficit round robin scheduler of the `builtin:prio` sched stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: RFC 4594 (DiffServ service classes), Shreedhar and Varghese, Efficient Fair Queuing using Deficit Round Robin,
+ *            RFC 8289 (CoDel) and RFC 8290 (FQ-CoDel).
+ *
+ *            Class 0 is the most urgent. The first `strict` classes are served by strict priority, the others share what
+ *            is left by deficit round robin, each receiving its weight times `quantum` bytes per round. Inside a class the
+ *            flows take turns of `quantum` bytes, flows that just became active first, and each flow is kept near `target`
+ *            ms of queueing by CoDel, which marks ECN capable packets with CE and drops the others.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef PRIO_H
+#define PRIO_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_PRIO_CLASSES     4
+#define MIXLINK_PRIO_CONTROL     0                                             //!< Network control, EF, CS6 and CS7, and traffic that is not IP, e.g., ARP
+#define MIXLINK_PRIO_INTERACTIVE 1                                             //!< AF3x, AF4x, CS3 to CS5, e.g., signaling and video
+#define MIXLINK_PRIO_DEFAULT     2
+#define MIXLINK_PRIO_BULK        3                                             //!< CS1 and AF1x, e.g., backups
+
+#define MIXLINK_PRIO_POOL        256                                           //!< Frames held by all the classes, when full the oldest frame of the longest flow is dropped
+#define MIXLINK_PRIO_FLOWS       16                                            //!< Flow queues of each class, a frame goes to the one its addresses, protocol and ports hash to
+#define MIXLINK_PRIO_FRAME_MAX   2048                                          //!< Longest frame held
+#define MIXLINK_PRIO_RULES       16                                            //!< Port rules of the argument `ports`, e.g., "22:1,1883:1,873:3"
+#define MIXLINK_PRIO_STRICT      1                                             //!< Default classes served by strict priority, argument `strict`
+#define MIXLINK_PRIO_QUANTUM     512                                           //!< Default bytes per round of a weight, argument `quantum`
+#define MIXLINK_PRIO_DEPTH       2                                             //!< Default buffers let past the scheduler before the serial port takes them, argument `depth`
+#define MIXLINK_PRIO_TARGET      500                                           //!< Default ms of queueing CoDel keeps each flow near, argument `target`, e.g., 500 for LoRa
+#define MIXLINK_PRIO_INTERVAL    5000                                          //!< Default ms the queueing may stay above `target` before CoDel acts, argument `interval`, about the worst RTT
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
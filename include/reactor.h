@@ -0,0 +1,243 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      reactor.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Event loop based on epoll, watches sockets, serial ports, timers and signals.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *            https://man7.org/linux/man-pages/man7/epoll.7.html
+ *            https://man7.org/linux/man-pages/man2/timerfd_create.2.html
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/epoll.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_REACTOR_MAX_EVENTS 32                                          //!< Maximum number of file descriptors watched by one reactor
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+struct mixlink_event;
+
+//!< Called when the file descriptor of the event is ready, returning -1 makes `mixlink_reactor_wait()` fail
+typedef int8_t (* mixlink_event_fn_t)(
+  struct mixlink_event * ev,
+  const uint32_t events
+);
+
+//!< A file descriptor watched by the reactor
+typedef struct mixlink_event{
+  int fd;
+  bool timer;                                                                  //!< The reactor owns `fd`, a timerfd that is drained before calling `fn`
+  mixlink_event_fn_t fn;
+  void * arg;                                                                  //!< Free for the owner of the event
+  struct mixlink_reactor * reactor;
+} mixlink_event_t;
+
+//!< Reactor object, one per thread
+typedef struct mixlink_reactor{
+  int epfd;
+  mixlink_event_t wake;                                                        //!< eventfd used to interrupt `mixlink_reactor_wait()` from other threads
+  mixlink_event_t ev[ MIXLINK_REACTOR_MAX_EVENTS ];
+  uint8_t nev;
+} mixlink_reactor_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Creates the epoll instance and the wake-up eventfd.
+ *
+ * @param[out] reactor The reactor to initialize.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_reactor_init(
+  mixlink_reactor_t * reactor
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Closes the epoll instance and every timer owned by the reactor, watched file descriptors are left open.
+ *
+ * @param[in,out] reactor The reactor to close.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_reactor_close(
+  mixlink_reactor_t * reactor
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Watches a file descriptor owned by the caller.
+ *
+ * @param[in,out] reactor The reactor.
+ * @param[in] fd The file descriptor, e.g., the raw socket or the serial port.
+ * @param[in] events The epoll events of interest, e.g., `EPOLLIN`.
+ * @param[in] fn The function called when the file descriptor is ready.
+ * @param[in] arg Stored in the event for `fn`.
+ *
+ * @return Upon success it returns the event. \n
+ *         Otherwise NULL is returned and errno is set.
+ *
+ *  - `EINVAL`: Invalid argument \n
+ *  - `ENOSPC`: The reactor is full \n
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+mixlink_event_t * mixlink_reactor_add_fd(
+  mixlink_reactor_t * reactor,
+  const int fd,
+  const uint32_t events,
+  mixlink_event_fn_t fn,
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Creates a disarmed one-shot timer, armed later with `mixlink_reactor_schedule()`.
+ *
+ * @param[in,out] reactor The reactor.
+ * @param[in] fn The function called when the timer expires.
+ * @param[in] arg Stored in the event for `fn`.
+ *
+ * @return Upon success it returns the event. \n
+ *         Otherwise NULL is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+mixlink_event_t * mixlink_reactor_add_timer(
+  mixlink_reactor_t * reactor,
+  mixlink_event_fn_t fn,
+  void * arg
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Changes the epoll events of interest of a watched file descriptor, 0 pauses the event.
+ *
+ * @param[in] ev The event.
+ * @param[in] events The epoll events of interest.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_reactor_watch(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Moves a watched event to another file descriptor, e.g., the serial port after a reopen, or detaches it with -1.
+ *
+ * Unlike `mixlink_reactor_watch()`, it also stops the hang-ups and errors epoll reports on a detached descriptor.
+ *
+ * @param[in,out] ev The event, not a timer.
+ * @param[in] fd The new file descriptor, -1 leaves the event unwatched.
+ * @param[in] events The epoll events of interest on `fd`.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned, errno is set and the event is left unwatched.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_reactor_rebind(
+  mixlink_event_t * ev,
+  const int fd,
+  const uint32_t events
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Arms a timer event to expire once after `ms` milliseconds, replacing any previous deadline.
+ *
+ * The signature matches the `schedule` and `wake` hooks of the module ABI, so `ctx` can be handed to modules as is.
+ * It can be called from any thread.
+ *
+ * @param[in] ctx The timer event, as returned by `mixlink_reactor_add_timer()`.
+ * @param[in] ms Milliseconds until the timer expires, 0 expires as soon as possible.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_reactor_schedule(
+  void * ctx,
+  const uint32_t ms
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Waits for events and dispatches them.
+ *
+ * @param[in,out] reactor The reactor.
+ * @param[in] timeout Maximum time to wait in milliseconds, -1 waits forever and 0 only polls.
+ *
+ * @return The number of events dispatched, 0 on timeout or interruption. \n
+ *         Otherwise -1 is returned and errno is set, also when a callback fails.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int mixlink_reactor_wait(
+  mixlink_reactor_t * reactor,
+  const int timeout
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Interrupts a `mixlink_reactor_wait()` in progress, or makes the next one return immediately.
+ *
+ * @param[in,out] reactor The reactor.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_reactor_wake(
+  mixlink_reactor_t * reactor
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,201 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      ring.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Bounded lock-free single-producer/single-consumer ring of buffer descriptors.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef RING_H
+#define RING_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "mixlinkabi.h"
+#include "pool.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Ring of `mixlink_buf8_t` descriptors, one thread produces and another (or the same) thread consumes
+typedef struct{
+  mixlink_buf8_t * slot;                                                       //!< Descriptors, `mask + 1` entries, owned by `pool`
+  mixlink_pool_t pool;                                                         //!< Buffers backing the descriptors, with `MIXLINK_BUF_HEADROOM` and `MIXLINK_BUF_TAILROOM`
+  size_t mask;                                                                 //!< Number of slots minus one, the number of slots is a power of two
+  size_t bufsize;                                                              //!< Capacity in bytes of each slot
+
+  size_t head __attribute__(( aligned( MIXLINK_CACHE_LINE ) ));                //!< Next slot to be published, only written by the producer
+  size_t tail_cache;                                                           //!< Producer copy of `tail`, avoids touching the consumer cache line
+
+  size_t tail __attribute__(( aligned( MIXLINK_CACHE_LINE ) ));                //!< Next slot to be consumed, only written by the consumer
+  size_t head_cache;                                                           //!< Consumer copy of `head`, avoids touching the producer cache line
+} mixlink_ring_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Allocates a ring with `slots` descriptors, each one backed by `bufsize` bytes plus the headroom and tailroom of the ABI.
+ *
+ * @param[out] ring The ring to initialize.
+ * @param[in] slots The number of descriptors, must be a power of two.
+ * @param[in] bufsize The capacity in bytes of each descriptor.
+ *
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set.
+ *
+ *  - `EINVAL`: Invalid argument \n
+ *  - `ENOMEM`: Not enough memory \n
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_ring_init(
+  mixlink_ring_t * ring,
+  const size_t slots,
+  const size_t bufsize
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the memory held by the ring.
+ *
+ * @param[in,out] ring The ring to release.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_ring_free(
+  mixlink_ring_t * ring
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Producer side, number of descriptors that can still be reserved.
+ *
+ * @param[in,out] ring The ring.
+ *
+ * @return The number of free slots.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+size_t mixlink_ring_space(
+  mixlink_ring_t * ring
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Producer side, returns the `idx`-th free descriptor ahead of the head, emptied and ready to be filled.
+ *
+ * @param[in,out] ring The ring.
+ * @param[in] idx The offset from the head, must be lower than `mixlink_ring_space()`.
+ *
+ * @return The descriptor, or NULL if there is no such free slot.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+mixlink_buf8_t * mixlink_ring_reserve(
+  mixlink_ring_t * ring,
+  const size_t idx
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Producer side, publishes `n` reserved descriptors to the consumer.
+ *
+ * @param[in,out] ring The ring.
+ * @param[in] n The number of descriptors to publish.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_ring_commit(
+  mixlink_ring_t * ring,
+  const size_t n
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Consumer side, number of descriptors ready to be consumed.
+ *
+ * @param[in,out] ring The ring.
+ *
+ * @return The number of published descriptors.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+size_t mixlink_ring_count(
+  mixlink_ring_t * ring
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Consumer side, returns the oldest published descriptor without removing it.
+ *
+ * @param[in,out] ring The ring.
+ *
+ * @return The descriptor, or NULL if the ring is empty.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+mixlink_buf8_t * mixlink_ring_front(
+  mixlink_ring_t * ring
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Consumer side, returns the published descriptor `idx` positions after the oldest one without removing it.
+ *
+ * @param[in,out] ring The ring.
+ * @param[in] idx Position from the oldest descriptor, 0 is the same as `mixlink_ring_front()`.
+ *
+ * @return The descriptor, or NULL if fewer than `idx + 1` descriptors are published.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+mixlink_buf8_t * mixlink_ring_peek(
+  mixlink_ring_t * ring,
+  const size_t idx
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Consumer side, gives `n` consumed descriptors back to the producer.
+ *
+ * @param[in,out] ring The ring.
+ * @param[in] n The number of descriptors to release.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_ring_release(
+  mixlink_ring_t * ring,
+  const size_t n
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,90 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      rohc.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Wire format and limits of the context-based header compressor of the `builtin:rohc` opt stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: RFC 3095 and RFC 6846 (ROHC), RFC 6282 (IPHC).
+ *
+ *            A frame starts with its type, a context identifier below `MIXLINK_ROHC_CONTEXTS` for a compressed header,
+ *            `MIXLINK_ROHC_IR` followed by the identifier and the whole frame to set up a context, or `MIXLINK_ROHC_RAW`
+ *            followed by the whole frame for traffic that is not compressed. A compressed header carries a byte of flags,
+ *            the low byte of the CRC32C of the original header and the fields the flags name, in this order: IP-ID, TCP
+ *            timestamps, sequence number, acknowledgement number, window and TCP flags, and the TCP or UDP checksum.
+ *
+ *            The fields are sent as their least significant bits (W-LSB, RFC 3095 section 4.5.2), as many as it takes to
+ *            decode them against any of the last `MIXLINK_ROHC_WINDOW` headers sent in the flow, with a quarter of the
+ *            interval below the reference, and are left out when they equal the field in all of them. The decompressor
+ *            only holds the last header it rebuilt, so packets lost on the link do not break the ones that follow.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef ROHC_H
+#define ROHC_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_ROHC_CONTEXTS    64                                            //!< Flows tracked at once, the slots of the hash table, power of two
+#define MIXLINK_ROHC_PROBE       4                                             //!< Slots searched from the hash of a flow, the least recently used one is replaced
+#define MIXLINK_ROHC_REFRESH     64                                            //!< Compressed headers between two context refreshes, so a receiver that lost one resynchronizes
+#define MIXLINK_ROHC_OPTIMISTIC  3                                             //!< First packets of a flow sent with the full header, so the context survives losing some of them
+#define MIXLINK_ROHC_HDR_MAX     128                                           //!< Longest header compressed, link, IP and TCP with options
+#define MIXLINK_ROHC_WINDOW      8                                             //!< Headers sent the compressor encodes against, up to one less may be lost in a row
+
+#define MIXLINK_ROHC_IR          0xFD                                          //!< Sets up the context given in the next byte
+#define MIXLINK_ROHC_RAW         0xFE                                          //!< The frame follows as is
+
+#define MIXLINK_ROHC_F_IPID      0x01                                          //!< 2 bytes, IPv4 identification, otherwise its low byte
+#define MIXLINK_ROHC_F_TS16      0x02                                          //!< 2 + 2 bytes, low bits of TSval and TSecr
+#define MIXLINK_ROHC_F_TS32      0x04                                          //!< 4 + 4 bytes, TSval and TSecr
+#define MIXLINK_ROHC_F_SEQ16     0x08                                          //!< 2 bytes, low bits of the sequence number
+#define MIXLINK_ROHC_F_SEQ32     0x10                                          //!< 4 bytes, sequence number
+#define MIXLINK_ROHC_F_ACK16     0x20                                          //!< 2 bytes, low bits of the acknowledgement number
+#define MIXLINK_ROHC_F_ACK32     0x40                                          //!< 4 bytes, acknowledgement number
+#define MIXLINK_ROHC_F_CTRL      0x80                                          //!< 2 + 1 bytes, window and TCP flags
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
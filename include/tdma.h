@@ -0,0 +1,77 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      tdma.h
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Wire format and limits of the half-duplex turn-taking MAC of the `builtin:tdma` mac stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: IEEE 802.4 (token passing), IEEE 802.15.4 section 5.1.1.1 (guaranteed time slots).
+ *
+ *            Every frame starts with a byte holding the identifier of the sender in its low nibble and, in token mode,
+ *            `MIXLINK_TDMA_TOKEN` when the frame hands the token to the next node, `(id + 1) % nodes`. A frame of that
+ *            byte alone only passes the token.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifndef TDMA_H
+#define TDMA_H
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdint.h>
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_TDMA_ID         0x0F                                           //!< Identifier of the sender
+#define MIXLINK_TDMA_TOKEN      0x80                                           //!< The sender hands the token to the next node
+
+#define MIXLINK_TDMA_NODES      16                                             //!< Nodes sharing the channel, one weight each in the argument `weights`, e.g., "2,1"
+#define MIXLINK_TDMA_QUEUE      32                                             //!< Frames held until a transmit opportunity, power of two
+#define MIXLINK_TDMA_FRAME_MAX  2048                                           //!< Longest frame held
+#define MIXLINK_TDMA_SLOT       500                                            //!< Default ms of a slot of weight 1, argument `slot`
+#define MIXLINK_TDMA_GUARD      50                                             //!< Default ms at the end of the slots of a node in which no frame starts, argument `guard`
+#define MIXLINK_TDMA_QUANTUM    256                                            //!< Default bytes a token holder sends per unit of weight, argument `quantum`
+#define MIXLINK_TDMA_GAP        50                                             //!< Default ms a holder waits for more frames before it passes the token alone, argument `gap`
+#define MIXLINK_TDMA_HOLD       2000                                           //!< Default limit of `gap`, doubled at every pass with nothing sent so idle nodes do not spend their duty cycle, argument `hold`
+#define MIXLINK_TDMA_TIMEOUT    5000                                           //!< Default ms of silence before node `id` takes a lost token, waited `id + 1` times, argument `timeout`
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * External C++ extern macro
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Definition file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
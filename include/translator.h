@@ -45,15 +45,49 @@
 extern "C" {        
 #endif
 
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define MIXLINK_NIC_RX_BLOCK_SIZE  (1 << 16)                                   //!< Bytes of each TPACKET_V3 block, multiple of the page size
+#define MIXLINK_NIC_RX_BLOCKS      32                                          //!< Blocks in the RX ring
+#define MIXLINK_NIC_RX_RETIRE_MS   2                                           //!< A partially filled block is handed to user space after this time
+#define MIXLINK_NIC_FRAME_SIZE     2048                                        //!< Bytes of each frame, fits an Ethernet frame plus the TPACKET header
+#define MIXLINK_NIC_TX_FRAMES      256                                         //!< Frames in the TX ring
+#define MIXLINK_NIC_BATCH          32                                          //!< Maximum frames moved by one `recvmmsg()` or `sendmmsg()`
+#define MIXLINK_NIC_TUN_PATH       "/dev/net/tun"                              //!< Clone device of the TUN/TAP driver
+
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * Data structures
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
+//!< Memory mapped rings of a NIC (PACKET_MMAP), RX uses TPACKET_V3 blocks on the NIC socket and TX uses TPACKET_V2 frames on a second socket
+struct nic_ring{
+  uint8_t * rx;                                                                //!< TPACKET_V3 blocks, NULL if the RX ring is not in use
+  uint32_t rx_block;                                                           //!< Block being consumed
+  uint32_t rx_left;                                                            //!< Packets of `rx_block` not yet released
+  uint8_t * rx_pkt;                                                            //!< Header of the current packet in `rx_block`
+
+  int tx_soc;                                                                  //!< Socket owning the TX ring, it never receives
+  uint8_t * tx;                                                                //!< TPACKET_V2 frames, NULL if the TX ring is not in use
+  uint32_t tx_frame;                                                           //!< Next frame to fill
+  uint32_t tx_pending;                                                         //!< Frames requested to send since the last flush
+};
+
+//!< How the translator reaches the NIC
+enum nic_backend{
+  NIC_BACKEND_SOCKET = 0,                                                      //!< Raw `AF_PACKET` socket bound to an existing NIC
+  NIC_BACKEND_TUN,                                                             //!< TUN device created by mixlink, the pipeline sees IP packets
+  NIC_BACKEND_TAP,                                                             //!< TAP device created by mixlink, the pipeline sees Ethernet frames
+};
+
 //!< Support to indicate the Network Interface Card (NIC)  
 struct nic_handler{
   char name[NAME_MAX];
-  int  soc;
+  int  soc;                                                                    //!< The raw socket, or the queue file descriptor of a TUN/TAP device
   bool enabled;
+  struct nic_ring ring;
+  enum nic_backend backend;
 };
 
 //!< Translator object that every function require 
@@ -64,7 +98,9 @@ typedef struct{
     struct nic_handler tx;
   } pair;
 
+  mixlink_module_t mac;                                                        //!< Link header elision, next to the NIC
   mixlink_module_t opt;
+  mixlink_module_t comp;                                                       //!< Payload compression between the opt and the framer
   mixlink_module_t framer;
 } mixlink_translator_t;
 
@@ -138,12 +174,147 @@ size_t mixlink_translator_read(
   const mixlink_translator_t * translator
 );
 
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Sends several frames to the opened NIC with a single `sendmmsg()`. 
+ * 
+ * @param[in] translator The translator object that have the socket.
+ * @param[in] data The frames to send, each one is a full Ethernet frame.
+ * @param[in] n The number of frames on `data`, at most `MIXLINK_NIC_BATCH` are sent.
+ * 
+ * @return The number of frames sent, frames after the first failure are not sent. \n
+ *         On error, the function returns 0 and sets `errno` to indicate the error.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+size_t mixlink_translator_write_batch(
+  const mixlink_translator_t * translator,
+  mixlink_buf8_t * const * data,
+  const size_t n
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Reads the frames waiting on the NIC with a single `recvmmsg()`, one frame per buffer, without blocking. 
+ * 
+ * @param[out] data The buffers to store the frames, `len` is set to the size of each frame received.
+ * @param[in] n The number of buffers on `data`, at most `MIXLINK_NIC_BATCH` are filled.
+ * @param[in] translator The translator object that have the socket.
+ * 
+ * @return The number of frames read, 0 if none is waiting. \n
+ *         On error, the function returns 0 and sets `errno` to indicate the error.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+size_t mixlink_translator_read_batch( 
+  mixlink_buf8_t * const * data,
+  const size_t n,
+  const mixlink_translator_t * translator
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Indicates if frames of the direction given go through a memory mapped ring.
+ * 
+ * @param[in] dir `MIXLINK_DIRECTION_FROM_NIC` for the RX ring, `MIXLINK_DIRECTION_TO_NIC` for the TX ring.
+ * @param[in] translator The translator object that have the socket.
+ * 
+ * @return True if the ring is mapped.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+bool mixlink_translator_ring(
+  const enum direction dir,
+  const mixlink_translator_t * translator
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Points `frame` to the oldest received frame still in the RX ring, without copying it. 
+ * 
+ * The frame stays valid, and is returned again by further calls, until `mixlink_translator_rx_release()`.
+ * 
+ * @param[out] frame Set to the frame inside the ring, `size` equals `len`.
+ * @param[in,out] translator The translator object that have the socket.
+ * 
+ * @return 1 if a frame is available, 0 if the ring is empty. \n
+ *         Otherwise -1 is returned and errno is set. 
+ * 
+ *  - `ENOTSUP`: The NIC has no RX ring \n
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_translator_rx_frame(
+  mixlink_buf8_t * frame,
+  mixlink_translator_t * translator
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Releases the frame returned by `mixlink_translator_rx_frame()`, the block goes back to the kernel after its last frame. 
+ * 
+ * @param[in,out] translator The translator object that have the socket.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_translator_rx_release(
+  mixlink_translator_t * translator
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Points `frame` to the next free frame of the TX ring, to be filled in place. 
+ * 
+ * @param[out] frame Set to the free frame inside the ring, with `len` 0.
+ * @param[in,out] translator The translator object that have the socket.
+ * 
+ * @return 1 if a frame is available, 0 if the ring is full. \n
+ *         Otherwise -1 is returned and errno is set. 
+ * 
+ *  - `ENOTSUP`: The NIC has no TX ring \n
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_translator_tx_frame(
+  mixlink_buf8_t * frame,
+  mixlink_translator_t * translator
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Hands the frame returned by `mixlink_translator_tx_frame()` to the kernel, it is sent on the next flush. 
+ * 
+ * @param[in] len The number of bytes written in the frame.
+ * @param[in,out] translator The translator object that have the socket.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+void mixlink_translator_tx_commit(
+  const size_t len,
+  mixlink_translator_t * translator
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Sends every committed frame of the TX ring with a single syscall. 
+ * 
+ * @param[in,out] translator The translator object that have the socket.
+ * 
+ * @return Upon success it returns 0. \n
+ *         Otherwise -1 is returned and errno is set. 
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t mixlink_translator_tx_flush(
+  mixlink_translator_t * translator
+);
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @brief Returns the socket serving the direction given, used to wait for I/O readiness. 
+ * 
+ * @param[in] dir Indication of the flow of information, `MIXLINK_DIRECTION_FROM_NIC` is the socket read by the translator.
+ * @param[in] translator The translator object that have the socket.
+ * 
+ * @return The socket, or -1 if no NIC serves that direction.
+ * 
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int mixlink_translator_fd(
+  const enum direction dir,
+  const mixlink_translator_t * translator
+);
+
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * Macros
 **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
 #define MIXLINK_TRANSLATOR_MODULES \
+  X(mac)                           \
   X(opt)                           \
+  X(comp)                          \
   X(framer)
 
 #define X(name) \
@@ -154,7 +325,8 @@ MIXLINK_TRANSLATOR_MODULES
 #undef X
 
 #define X(name) \
-    MIXLINK_GEN_IO_MODULES_DECL( translator, name, io, mixlink_translator_t )
+    MIXLINK_GEN_IO_MODULES_DECL( translator, name, io, mixlink_translator_t ) \
+    MIXLINK_GEN_IO_MODULES_DECL( translator, name, batch, mixlink_translator_t )
 MIXLINK_TRANSLATOR_MODULES
 #undef X
 
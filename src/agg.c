@@ -0,0 +1,361 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      agg.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Small-frame aggregation of the `builtin:agg` controller stage, packs the frames ready within a hold-off into one packet.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: IEEE 802.11n A-MSDU (aggregation of small frames in one transmission).
+ *
+ *            Every packet pays the preamble, header and turnaround of the radio, so the frames that follow each other
+ *            within `hold` milliseconds share one, up to `max` bytes. A frame arriving after the link was quiet for `hold`
+ *            is sent at once, so isolated traffic, e.g., a keystroke, is not delayed, only bursts wait for the packet to
+ *            fill or for the deadline, which the event loop delivers as a kick.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "agg.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+typedef struct{
+  size_t max;                                                                  //!< Longest packet, argument `max`
+  uint32_t hold;                                                               //!< Wait for more frames, argument `hold` in milliseconds
+  uint64_t last;                                                               //!< Arrival of the last frame, in milliseconds
+
+  uint8_t buf[ MIXLINK_AGG_MAX_SIZE ];                                         //!< Frames waiting, back to back
+  uint16_t lens[ MIXLINK_AGG_FRAMES ];
+  uint8_t count;
+  size_t used;                                                                 //!< Bytes of `buf` in use
+  size_t size;                                                                 //!< Bytes of the packet if it was sent now
+
+  uint8_t rx[ 2 * MIXLINK_AGG_MAX_SIZE ];                                      //!< Frames received that the next ring had no room for, back to back
+  uint16_t rx_lens[ 2 * MIXLINK_AGG_FRAMES ];
+  uint8_t rx_count;
+  size_t rx_used;                                                              //!< Bytes of `rx` in use
+} agg_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+uint64_t agg_now(
+  void
+);
+
+size_t agg_prefix(
+  const size_t len
+);
+
+int8_t agg_flush(
+  agg_t * agg,
+  mixlink_buf8_t * out
+);
+
+void agg_deliver(
+  agg_t * agg,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+agg_now(
+  void
+){
+  struct timespec ts;
+  (void) clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint64_t) ts.tv_sec * 1000u + (uint64_t) ts.tv_nsec / 1000000u;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+agg_prefix(
+  const size_t len
+){
+  return ( 0x80 > len ) ? 1 : 2;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+agg_flush(
+  agg_t * agg,
+  mixlink_buf8_t * out
+){
+  if( out->size < agg->size ){
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  uint8_t * op = out->val;
+  const uint8_t * ip = agg->buf;
+  *op ++ = agg->count;
+
+  for( uint8_t i = 0 ; i < agg->count ; ++i ){
+    const uint16_t len = agg->lens[i];
+    if( i + 1 < agg->count && 0x80 > len )
+      *op ++ = (uint8_t) len;
+    else if( i + 1 < agg->count ){
+      *op ++ = (uint8_t) ( 0x80 | len >> 8 );
+      *op ++ = (uint8_t) len;
+    }
+
+    (void) memcpy( op, ip, len );
+    op += len;
+    ip += len;
+  }
+
+  out->len = (size_t) ( op - out->val );
+  agg->count = 0;
+  agg->used = 0;
+  agg->size = 0;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+agg_deliver(
+  agg_t * agg,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+){
+  uint8_t i = 0;
+  size_t at = 0;
+  for( ; i < agg->rx_count && *n < abi->n_out ; ++i ){
+    const uint16_t len = agg->rx_lens[i];
+    mixlink_buf8_t * out = abi->out[ *n ];
+    if( len <= out->size ){
+      (void) memcpy( out->val, &agg->rx[ at ], len );
+      out->len = len;
+      ( *n ) ++;
+    }
+    at += len;
+  }
+
+  agg->rx_count = (uint8_t) ( agg->rx_count - i );
+  agg->rx_used -= at;
+  (void) memmove( agg->rx_lens, &agg->rx_lens[i], agg->rx_count * sizeof(uint16_t) );
+  (void) memmove( agg->rx, &agg->rx[ at ], agg->rx_used );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_agg_init(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  if( def->priv )
+    return 0;
+
+  // A frame of 0x8000 bytes or more would not fit its length prefix
+  const long max = mixlink_abi_arg( def->args, "max", MIXLINK_AGG_MAX );
+  const long hold = mixlink_abi_arg( def->args, "hold", MIXLINK_AGG_HOLD_MS );
+  if( 4 > max || MIXLINK_AGG_MAX_SIZE < max || 0 > hold || MIXLINK_AGG_HOLD_MAX_MS < hold ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  agg_t * agg = calloc( 1, sizeof(agg_t) );
+  if( !agg )
+    return -1;
+
+  agg->max = (size_t) max;
+  agg->hold = (uint32_t) hold;
+  def->priv = agg;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_agg_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  free( def->priv );
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_agg_tx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  agg_t * agg = (agg_t *) abi->priv;
+  uint8_t n = 0;
+
+  // The hold-off expired
+  if( !abi->n_in ){
+    if( agg->count && -1 == agg_flush( agg, abi->out[ n ++ ] ) )
+      return -1;
+    abi->n_out = n;
+    return n ? 0 : 1;
+  }
+
+  const mixlink_buf8_t * in = abi->in[0];
+  const uint64_t now = agg_now();
+  const bool idle = ( now - agg->last >= agg->hold );
+  agg->last = now;
+
+  if( agg->count && ( MIXLINK_AGG_FRAMES == agg->count || agg->max < agg->size + agg_prefix( agg->lens[ agg->count - 1 ] ) + in->len ) )
+    if( -1 == agg_flush( agg, abi->out[ n ++ ] ) )
+      return -1;
+
+  if( agg->max < 1 + in->len ){
+    // Larger than any packet, the segmenter should have split it, it goes alone
+    if( n == abi->n_out ){
+      errno = ENOBUFS;
+      return -1;
+    }
+
+    mixlink_buf8_t * out = abi->out[ n ++ ];
+    if( out->size < 1 + in->len ){
+      errno = EMSGSIZE;
+      return -1;
+    }
+    out->val[0] = 1;
+    (void) memcpy( &out->val[1], in->val, in->len );
+    out->len = 1 + in->len;
+  }
+  else{
+    agg->size += agg->count ? agg_prefix( agg->lens[ agg->count - 1 ] ) + in->len : 1 + in->len;
+    agg->lens[ agg->count ++ ] = (uint16_t) in->len;
+    (void) memcpy( &agg->buf[ agg->used ], in->val, in->len );
+    agg->used += in->len;
+
+    // Without a free output the packet waits for the deadline
+    const bool flush = ( 1 == agg->count ) ? idle || !abi->wake : agg->max < agg->size + agg_prefix( in->len ) + 1;
+    if( flush && n < abi->n_out ){
+      if( -1 == agg_flush( agg, abi->out[ n ++ ] ) )
+        return -1;
+    }
+    else if( 1 == agg->count && abi->wake )
+      (void) abi->wake( abi->wake_ctx, agg->hold );
+  }
+
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_agg_rx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  agg_t * agg = (agg_t *) abi->priv;
+  uint8_t n = 0;
+
+  // The frames the next ring had no room for leave first, a kick only delivers them
+  agg_deliver( agg, abi, &n );
+  if( abi->n_in ){
+    const mixlink_buf8_t * in = abi->in[0];
+    const uint8_t count = in->len ? in->val[0] : 0;
+    if( !count || MIXLINK_AGG_FRAMES < count ){
+      errno = EBADMSG;
+      return -1;
+    }
+
+    // The whole packet is checked before any of its frames is handed on
+    size_t offs[ MIXLINK_AGG_FRAMES ];
+    size_t lens[ MIXLINK_AGG_FRAMES ];
+    size_t at = 1;
+    for( uint8_t i = 0 ; i < count ; ++i ){
+      size_t len = in->len - at;
+      if( i + 1 < count ){
+        if( at >= in->len || ( ( 0x80 & in->val[ at ] ) && at + 1 >= in->len ) ){
+          errno = EBADMSG;
+          return -1;
+        }
+        len = in->val[ at ++ ];
+        if( 0x80 & len )
+          len = ( len & 0x7F ) << 8 | in->val[ at ++ ];
+      }
+
+      if( len > in->len - at || len > abi->out[0]->size ){
+        errno = EBADMSG;
+        return -1;
+      }
+      offs[i] = at;
+      lens[i] = len;
+      at += len;
+    }
+
+    // The ring only guarantees one free slot, the rest waits for the next kick
+    const uint8_t direct = agg->rx_count ? 0 : (uint8_t) ( ( count < abi->n_out - n ) ? count : abi->n_out - n );
+    if( direct < count && ( sizeof(agg->rx) - agg->rx_used < in->len - offs[ direct ] || 2 * MIXLINK_AGG_FRAMES - agg->rx_count < count - direct ) ){
+      errno = ENOBUFS;
+      return -1;
+    }
+
+    uint8_t i = 0;
+    for( ; i < direct ; ++i ){
+      mixlink_buf8_t * out = abi->out[ n ++ ];
+      (void) memcpy( out->val, &in->val[ offs[i] ], lens[i] );
+      out->len = lens[i];
+    }
+    for( ; i < count ; ++i ){
+      (void) memcpy( &agg->rx[ agg->rx_used ], &in->val[ offs[i] ], lens[i] );
+      agg->rx_used += lens[i];
+      agg->rx_lens[ agg->rx_count ++ ] = (uint16_t) lens[i];
+    }
+  }
+
+  if( agg->rx_count && abi->wake )
+    (void) abi->wake( abi->wake_ctx, 0 );
+
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,251 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      air.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Time on air of the LoRa packets, duty cycle budget and rate shaper that pace the serial writes of the TX direction.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: Semtech AN1200.13 (LoRa modem designer's guide), SX1276 datasheet section 4.1.1.7, ETSI EN 300 220-2.
+ *
+ *            The budget is a token bucket of airtime refilled at `duty` microseconds per millisecond. A write leaves the
+ *            sink only once the budget covers it, so the transceiver never has to hold it back for its own duty cycle
+ *            timer, and what cannot go yet waits in the rings and in the scheduler, where it may still be reordered.
+ *
+ *            The shaper is a leaky bucket of the bytes handed to the transceiver and not sent yet, emptied at `rate`.
+ *            Writing beyond `burst` only grows the UART buffer of the transceiver, which drops what overflows and leaves
+ *            the loss to the ARQ; the `ready` hook of the driver or the CTS line may hold the writes further.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "air.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+uint64_t air_now(
+  void
+);
+
+uint64_t air_packet(
+  const mixlink_abi_radio_t * radio,
+  const size_t len
+);
+
+void air_refill(
+  mixlink_air_t * air
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+air_now(
+  void
+){
+  struct timespec ts;
+  (void) clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint64_t) ts.tv_sec * 1000000u + (uint64_t) ts.tv_nsec / 1000u;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+air_packet(
+  const mixlink_abi_radio_t * radio,
+  const size_t len
+){
+  const int64_t sf = radio->sf;
+  const int64_t de = ( ( 1 << sf ) * 1000 > 16 * (int64_t) radio->bw ) ? 1 : 0;
+  const int64_t bits = 8 * (int64_t) len - 4 * sf + 28 + ( radio->crc ? 16 : 0 ) - ( radio->implicit ? 20 : 0 );
+  const int64_t group = 4 * ( sf - 2 * de );
+  const int64_t payload = 8 + ( ( 0 < bits ) ? ( bits + group - 1 ) / group * radio->cr : 0 );
+
+  // In quarters of a symbol, the preamble ends with 4.25 symbols of sync word and start of frame
+  const uint64_t quarters = (uint64_t) ( 4 * (int64_t) radio->preamble + 17 + 4 * payload );
+  return ( quarters << sf ) * 1000000u / ( 4u * (uint64_t) radio->bw );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+mixlink_air_time(
+  const mixlink_abi_radio_t * radio,
+  const size_t len
+){
+  if( !radio || !radio->sf || !radio->bw || !radio->payload )
+    return 0;
+
+  const size_t full = len / radio->payload;
+  const size_t rest = len % radio->payload;
+  return (uint64_t) full * air_packet( radio, radio->payload ) + ( rest ? air_packet( radio, rest ) : 0 );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+air_refill(
+  mixlink_air_t * air
+){
+  const uint64_t now = air_now();
+
+  const uint64_t elapsed = now - air->last;
+  air->last = now;
+
+  // `duty` thousandths of every microsecond, in nanoseconds
+  air->tokens += (int64_t) ( elapsed * air->radio.duty );
+  if( air->tokens > air->capacity )
+    air->tokens = air->capacity;
+
+  // `rate` bytes per second are `rate` millionths per microsecond
+  const uint64_t sent = elapsed * air->radio.rate;
+  air->level = ( air->level > sent ) ? air->level - sent : 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_air_init(
+  mixlink_air_t * air,
+  const mixlink_abi_radio_t * radio,
+  const char * args
+){
+  if( !air ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  (void) memset( air, 0, sizeof(mixlink_air_t) );
+  if( radio )
+    air->radio = *radio;
+
+  mixlink_abi_radio_t * r = &air->radio;
+  const long sf       = mixlink_abi_arg( args, "sf", r->sf );
+  const long bw       = mixlink_abi_arg( args, "bw", (long) r->bw );
+  const long cr       = mixlink_abi_arg( args, "cr", r->cr ? r->cr : 5 );
+  const long preamble = mixlink_abi_arg( args, "preamble", r->preamble ? r->preamble : MIXLINK_AIR_PREAMBLE );
+  const long payload  = mixlink_abi_arg( args, "payload", r->payload ? r->payload : MIXLINK_AIR_PAYLOAD );
+  const long duty     = mixlink_abi_arg( args, "duty", r->duty );
+  const long window   = mixlink_abi_arg( args, "window", MIXLINK_AIR_WINDOW );
+  const long buffer   = mixlink_abi_arg( args, "buffer", r->buffer );
+  const long rate     = mixlink_abi_arg( args, "rate", (long) r->rate );
+  if( ( sf && ( 6 > sf || 12 < sf ) ) || 0 > bw || 5 > cr || 8 < cr || 0 > preamble || 0xFFFF < preamble ){
+    errno = EINVAL;
+    return -1;
+  }
+  if( 0 >= payload || MIXLINK_AIR_PAYLOAD < payload || 0 > duty || 1000 < duty || 0 >= window || 3600 < window ){
+    errno = EINVAL;
+    return -1;
+  }
+  if( 0 > buffer || 0xFFFF < buffer || 0 > rate || 0xFFFFFFF < rate ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  r->sf       = (uint8_t) sf;
+  r->bw       = (uint32_t) bw;
+  r->cr       = (uint8_t) cr;
+  r->preamble = (uint16_t) preamble;
+  r->payload  = (uint16_t) payload;
+  r->duty     = (uint16_t) duty;
+  r->crc      = 0 != mixlink_abi_arg( args, "crc", r->crc );
+  r->implicit = 0 != mixlink_abi_arg( args, "implicit", r->implicit );
+  r->buffer   = (uint16_t) buffer;
+  r->rate     = (uint32_t) rate;
+
+  // Full packets back to back, the best the transceiver does
+  const uint64_t airtime = mixlink_air_time( r, r->payload );
+  if( !r->rate && airtime )
+    r->rate = (uint32_t) ( (uint64_t) r->payload * 1000000u / airtime );
+
+  air->burst = (uint32_t) mixlink_abi_arg( args, "burst", 2 * r->payload );
+  if( r->buffer && air->burst > r->buffer )
+    air->burst = r->buffer;
+  if( !air->burst ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  // The budget starts full, a window of duty cycle stays under the hour the regulation averages over
+  if( airtime && r->duty && 1000 > r->duty )
+    air->capacity = (int64_t) ( (uint64_t) window * 1000000u * r->duty );
+  else
+    r->duty = 0;
+  air->tokens = air->capacity;
+  air->last = air_now();
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint32_t
+mixlink_air_wait(
+  mixlink_air_t * air,
+  const size_t len
+){
+  if( !air || ( !air->capacity && !air->radio.rate ) )
+    return 0;
+
+  air_refill( air );
+
+  uint32_t wait = 0;
+  if( air->capacity ){
+    int64_t need = (int64_t) mixlink_air_time( &air->radio, len ) * 1000;
+    if( need > air->capacity )
+      need = air->capacity;
+
+    // The budget gains `duty` microseconds per millisecond
+    const int64_t gain = 1000 * (int64_t) air->radio.duty;
+    if( air->tokens < need )
+      wait = (uint32_t) ( ( need - air->tokens + gain - 1 ) / gain );
+  }
+
+  if( air->radio.rate ){
+    const uint64_t room = (uint64_t) air->burst * 1000000u;
+    const uint64_t need = ( len < air->burst ) ? air->level + (uint64_t) len * 1000000u : air->level + room;
+
+    // Every millisecond the transceiver sends `rate` / 1000 bytes
+    const uint64_t drain = 1000u * (uint64_t) air->radio.rate;
+    if( need > room ){
+      const uint32_t ms = (uint32_t) ( ( need - room + drain - 1 ) / drain );
+      wait = ( ms > wait ) ? ms : wait;
+    }
+  }
+
+  return wait;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_air_sent(
+  mixlink_air_t * air,
+  const size_t len
+){
+  if( !air )
+    return;
+
+  if( air->capacity )
+    air->tokens -= (int64_t) mixlink_air_time( &air->radio, len ) * 1000;
+  if( air->radio.rate )
+    air->level += (uint64_t) len * 1000000u;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
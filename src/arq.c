@@ -0,0 +1,698 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      arq.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Selective-repeat ARQ of the `builtin:sr` QoS stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: RFC 2018 (SACK), RFC 6298 (retransmission timer), RFC 8985 (RACK).
+ *
+ *            The TX thread sends and retransmits, the RX thread takes the acknowledgements and reorders the data, so the
+ *            state of an instance is shared by both and kept under a lock. Only the segments the peer did not acknowledge
+ *            are sent again, either when their own timeout expires or once `MIXLINK_ARQ_DUPTHRESH` segments sent after
+ *            them were acknowledged. The acknowledgements ride on the data of the reverse direction, and are sent alone
+ *            only if none goes out within `delay` ms.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/random.h>
+
+#include "arq.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define ARQ_QUEUE_MASK  ( MIXLINK_ARQ_QUEUE - 1 )
+#define ARQ_WINDOW_MASK ( MIXLINK_ARQ_WINDOW_MAX - 1 )
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< A segment queued by the sender
+typedef struct{
+  uint8_t val[ MIXLINK_ARQ_MAX_SEGMENT ];
+  uint16_t len;
+  bool sacked;                                                                 //!< The peer holds it, but not every segment before it
+  bool lost;                                                                   //!< Declared lost, sent again by the next pump
+  uint8_t retries;
+  uint64_t sent;                                                               //!< Time of the last transmission, in ms
+  uint32_t order;                                                              //!< Transmission counter at the last transmission
+} arq_slot_t;
+
+//!< A segment received ahead of a missing one
+typedef struct{
+  uint8_t val[ MIXLINK_ARQ_MAX_SEGMENT ];
+  uint16_t len;
+  bool have;
+} arq_hold_t;
+
+typedef struct{
+  pthread_mutex_t lock;
+  uint16_t window;
+  bool adapt;                                                                  //!< The window follows the `arq_window` of the link policy, argument `adapt`
+  uint32_t delay;
+
+  arq_slot_t snd[ MIXLINK_ARQ_QUEUE ];
+  uint16_t snd_una;                                                            //!< Oldest segment not acknowledged
+  uint16_t snd_nxt;                                                            //!< Next segment never sent
+  uint16_t snd_end;                                                            //!< Next free slot of the queue
+  bool synced;                                                                 //!< The peer acknowledged once, `MIXLINK_ARQ_SYNC` is no longer sent
+  uint32_t order;
+  bool rtt_valid;
+  uint32_t srtt;
+  uint32_t rttvar;
+  uint32_t rto;
+
+  uint32_t sent;                                                               //!< First transmissions since the last report
+  uint32_t lost;                                                               //!< Segments declared lost since the last report
+  uint32_t bursts;
+  uint16_t last_lost;
+
+  arq_hold_t rcv[ MIXLINK_ARQ_WINDOW_MAX ];
+  uint16_t rcv_nxt;                                                            //!< Next segment expected
+  bool rcv_valid;                                                              //!< A segment was received, `rcv_nxt` is meaningful
+  bool ack_owed;                                                               //!< Data arrived since the last acknowledgement sent
+} arq_ctx_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+uint64_t arq_now(
+  void
+);
+
+uint64_t arq_rto(
+  const arq_ctx_t * ctx,
+  const uint8_t retries
+);
+
+void arq_rtt(
+  arq_ctx_t * ctx,
+  const arq_slot_t * slot,
+  const uint64_t now
+);
+
+void arq_loss(
+  arq_ctx_t * ctx,
+  const uint16_t seq,
+  mixlink_abi_link_t * link
+);
+
+size_t arq_header(
+  arq_ctx_t * ctx,
+  uint8_t * hdr,
+  const uint8_t flags,
+  const uint16_t seq
+);
+
+bool arq_emit(
+  arq_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n,
+  const uint16_t seq,
+  const uint64_t now
+);
+
+void arq_pump(
+  arq_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+);
+
+bool arq_on_ack(
+  arq_ctx_t * ctx,
+  const uint16_t ack,
+  const uint64_t sack,
+  mixlink_abi_link_t * link
+);
+
+void arq_on_data(
+  arq_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n,
+  const uint16_t seq,
+  const bool sync,
+  const uint8_t * val,
+  const size_t len
+);
+
+void arq_drain(
+  arq_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+arq_now(
+  void
+){
+  struct timespec ts;
+  (void) clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint64_t) ts.tv_sec * 1000u + (uint64_t) ts.tv_nsec / 1000000u;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+arq_rto(
+  const arq_ctx_t * ctx,
+  const uint8_t retries
+){
+  uint64_t rto = ctx->rto;
+  for( uint8_t i = 0 ; i < retries && MIXLINK_ARQ_RTO_MAX_MS > rto ; ++i )
+    rto <<= 1;
+  return ( MIXLINK_ARQ_RTO_MAX_MS < rto ) ? MIXLINK_ARQ_RTO_MAX_MS : rto;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+arq_rtt(
+  arq_ctx_t * ctx,
+  const arq_slot_t * slot,
+  const uint64_t now
+){
+  // Karn's algorithm, the acknowledgement of a retransmission cannot tell which transmission it answers
+  if( slot->retries || !slot->sent || now < slot->sent )
+    return;
+
+  const uint32_t r = (uint32_t) ( now - slot->sent );
+  if( !ctx->rtt_valid ){
+    ctx->srtt = r;
+    ctx->rttvar = r / 2;
+    ctx->rtt_valid = true;
+  }
+  else{
+    const uint32_t err = ( ctx->srtt > r ) ? ctx->srtt - r : r - ctx->srtt;
+    ctx->rttvar = ( 3 * ctx->rttvar + err ) / 4;
+    ctx->srtt = ( 7 * ctx->srtt + r ) / 8;
+  }
+
+  uint32_t rto = ctx->srtt + ( ctx->rttvar ? 4 * ctx->rttvar : 1 );
+  if( MIXLINK_ARQ_RTO_MIN_MS > rto )
+    rto = MIXLINK_ARQ_RTO_MIN_MS;
+  if( MIXLINK_ARQ_RTO_MAX_MS < rto )
+    rto = MIXLINK_ARQ_RTO_MAX_MS;
+  ctx->rto = rto;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+arq_loss(
+  arq_ctx_t * ctx,
+  const uint16_t seq,
+  mixlink_abi_link_t * link
+){
+  ctx->lost ++;
+  if( !ctx->bursts || (uint16_t) ( ctx->last_lost + 1 ) != seq )
+    ctx->bursts ++;
+  ctx->last_lost = seq;
+
+  if( MIXLINK_ARQ_REPORT > ctx->sent )
+    return;
+
+  // With an adaptive FEC below, only the losses it could not rebuild reach here, so the policy keeps its own measure
+  if( link && !__atomic_load_n( &link->fec_k, __ATOMIC_RELAXED ) )
+    mixlink_abi_link_peer(
+      link,
+      (uint32_t) ( (uint64_t) ctx->lost * 1000000u / ctx->sent ),
+      ctx->lost * 100u / ctx->bursts
+    );
+
+  ctx->sent = ctx->lost = ctx->bursts = 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+arq_header(
+  arq_ctx_t * ctx,
+  uint8_t * hdr,
+  const uint8_t flags,
+  const uint16_t seq
+){
+  size_t len = 1;
+  uint8_t f = flags;
+
+  if( MIXLINK_ARQ_DATA & flags ){
+    hdr[ len ++ ] = (uint8_t) seq;
+    hdr[ len ++ ] = (uint8_t) ( seq >> 8 );
+    if( !ctx->synced )
+      f |= MIXLINK_ARQ_SYNC;
+  }
+
+  if( ctx->rcv_valid ){
+    uint64_t sack = 0;
+    for( uint16_t i = 1 ; i < MIXLINK_ARQ_WINDOW_MAX ; ++i )
+      if( ctx->rcv[ (uint16_t) ( ctx->rcv_nxt + i ) & ARQ_WINDOW_MASK ].have )
+        sack |= (uint64_t) 1 << ( i - 1 );
+
+    // Only the bytes up to the last segment held are sent, none while nothing is missing
+    uint8_t bytes = 0;
+    while( bytes < 8 && ( sack >> ( 8 * bytes ) ) )
+      bytes ++;
+
+    f |= MIXLINK_ARQ_ACK | (uint8_t) ( bytes << 4 );
+    hdr[ len ++ ] = (uint8_t) ctx->rcv_nxt;
+    hdr[ len ++ ] = (uint8_t) ( ctx->rcv_nxt >> 8 );
+    for( uint8_t i = 0 ; i < bytes ; ++i )
+      hdr[ len ++ ] = (uint8_t) ( sack >> ( 8 * i ) );
+
+    ctx->ack_owed = false;
+  }
+
+  hdr[0] = f;
+  return len;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+arq_emit(
+  arq_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n,
+  const uint16_t seq,
+  const uint64_t now
+){
+  arq_slot_t * slot = &ctx->snd[ seq & ARQ_QUEUE_MASK ];
+  mixlink_buf8_t * out = abi->out[ *n ];
+  if( out->size < (size_t) MIXLINK_ARQ_HDR_MAX + slot->len )
+    return false;
+
+  out->len = arq_header( ctx, out->val, MIXLINK_ARQ_DATA, seq );
+  (void) memcpy( &out->val[ out->len ], slot->val, slot->len );
+  out->len += slot->len;
+
+  slot->sent  = now;
+  slot->order = ++ ctx->order;
+  slot->lost  = false;
+  ( *n ) ++;
+  return true;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+arq_pump(
+  arq_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+){
+  const uint64_t now = arq_now( );
+  uint16_t window = ctx->window;
+  if( ctx->adapt && abi->link ){
+    const uint16_t w = __atomic_load_n( &abi->link->arq_window, __ATOMIC_RELAXED );
+    if( w )
+      window = ( MIXLINK_ARQ_WINDOW_MAX < w ) ? MIXLINK_ARQ_WINDOW_MAX : w;
+  }
+
+  bool more = false;
+
+  // Retransmissions go first, they hold back the delivery of everything after them
+  for( uint16_t s = ctx->snd_una ; s != ctx->snd_nxt ; ++s ){
+    arq_slot_t * slot = &ctx->snd[ s & ARQ_QUEUE_MASK ];
+    if( slot->sacked || ( !slot->lost && now < slot->sent + arq_rto( ctx, slot->retries ) ) )
+      continue;
+
+    if( *n >= abi->n_out ){
+      more = true;
+      break;
+    }
+
+    if( !slot->lost )
+      arq_loss( ctx, s, abi->link );
+    if( UINT8_MAX > slot->retries )
+      slot->retries ++;
+    if( !arq_emit( ctx, abi, n, s, now ) )
+      slot->lost = true;
+  }
+
+  while( ctx->snd_nxt != ctx->snd_end && window > (uint16_t) ( ctx->snd_nxt - ctx->snd_una ) ){
+    if( *n >= abi->n_out ){
+      more = true;
+      break;
+    }
+    if( !arq_emit( ctx, abi, n, ctx->snd_nxt, now ) )
+      break;
+    ctx->snd_nxt ++;
+    ctx->sent ++;
+  }
+
+  if( ctx->ack_owed && *n < abi->n_out && abi->out[ *n ]->size >= MIXLINK_ARQ_HDR_MAX ){
+    mixlink_buf8_t * out = abi->out[ ( *n ) ++ ];
+    out->len = arq_header( ctx, out->val, 0, 0 );
+  }
+
+  if( !abi->wake )
+    return;
+
+  if( more ){
+    (void) abi->wake( abi->wake_ctx, 0 );
+    return;
+  }
+
+  // One timer serves every segment in flight, armed for the earliest timeout
+  uint64_t next = UINT64_MAX;
+  for( uint16_t s = ctx->snd_una ; s != ctx->snd_nxt ; ++s ){
+    const arq_slot_t * slot = &ctx->snd[ s & ARQ_QUEUE_MASK ];
+    const uint64_t due = slot->sent + arq_rto( ctx, slot->retries );
+    if( !slot->sacked && due < next )
+      next = due;
+  }
+
+  if( UINT64_MAX != next )
+    (void) abi->wake( abi->wake_ctx, ( next > now ) ? (uint32_t) ( next - now ) : 0 );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+arq_on_ack(
+  arq_ctx_t * ctx,
+  const uint16_t ack,
+  const uint64_t sack,
+  mixlink_abi_link_t * link
+){
+  const uint64_t now = arq_now( );
+  const uint16_t flight = (uint16_t) ( ctx->snd_nxt - ctx->snd_una );
+
+  // Acknowledgements outside the flight are late or belong to a previous session of the peer
+  if( (uint16_t) ( ack - ctx->snd_una ) > flight )
+    return false;
+
+  const bool moved = ( ack != ctx->snd_una );
+  ctx->synced = true;
+
+  for( ; ctx->snd_una != ack ; ctx->snd_una ++ ){
+    arq_slot_t * slot = &ctx->snd[ ctx->snd_una & ARQ_QUEUE_MASK ];
+    if( !slot->sacked )
+      arq_rtt( ctx, slot, now );
+    slot->sacked = false;
+  }
+
+  uint32_t top[ MIXLINK_ARQ_DUPTHRESH ] = { 0 };
+  for( uint16_t s = ctx->snd_una ; s != ctx->snd_nxt ; ++s ){
+    arq_slot_t * slot = &ctx->snd[ s & ARQ_QUEUE_MASK ];
+    const uint16_t bit = (uint16_t) ( s - ack - 1 );
+    if( !slot->sacked && s != ack && 64 > bit && ( ( sack >> bit ) & 1u ) ){
+      slot->sacked = true;
+      arq_rtt( ctx, slot, now );
+    }
+
+    // The orders of the latest transmissions the peer holds, the lowest of them is the threshold
+    if( slot->sacked && slot->order > top[ MIXLINK_ARQ_DUPTHRESH - 1 ] ){
+      uint8_t i = MIXLINK_ARQ_DUPTHRESH - 1;
+      for( ; i && slot->order > top[ i - 1 ] ; --i )
+        top[i] = top[ i - 1 ];
+      top[i] = slot->order;
+    }
+  }
+
+  bool lost = false;
+  for( uint16_t s = ctx->snd_una ; top[ MIXLINK_ARQ_DUPTHRESH - 1 ] && s != ctx->snd_nxt ; ++s ){
+    arq_slot_t * slot = &ctx->snd[ s & ARQ_QUEUE_MASK ];
+    if( slot->sacked || slot->lost || slot->order >= top[ MIXLINK_ARQ_DUPTHRESH - 1 ] )
+      continue;
+    slot->lost = true;
+    arq_loss( ctx, s, link );
+    lost = true;
+  }
+
+  return moved || lost;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+arq_drain(
+  arq_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+){
+  for( ; *n < abi->n_out ; ctx->rcv_nxt ++ ){
+    arq_hold_t * hold = &ctx->rcv[ ctx->rcv_nxt & ARQ_WINDOW_MASK ];
+    if( !hold->have || abi->out[ *n ]->size < hold->len )
+      break;
+
+    (void) memcpy( abi->out[ *n ]->val, hold->val, hold->len );
+    abi->out[ ( *n ) ++ ]->len = hold->len;
+    hold->have = false;
+  }
+
+  if( ctx->rcv[ ctx->rcv_nxt & ARQ_WINDOW_MASK ].have && abi->wake )
+    (void) abi->wake( abi->wake_ctx, 0 );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+arq_on_data(
+  arq_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n,
+  const uint16_t seq,
+  const bool sync,
+  const uint8_t * val,
+  const size_t len
+){
+  const bool far = ( MIXLINK_ARQ_WINDOW_MAX <= (uint16_t) ( seq - ctx->rcv_nxt ) ) && ( MIXLINK_ARQ_WINDOW_MAX < (uint16_t) ( ctx->rcv_nxt - seq ) );
+
+  // The first segment, or a restarted peer, sets where the sequence starts
+  if( !ctx->rcv_valid || ( sync && far ) ){
+    for( uint16_t i = 0 ; i < MIXLINK_ARQ_WINDOW_MAX ; ++i )
+      ctx->rcv[i].have = false;
+    ctx->rcv_nxt = seq;
+    ctx->rcv_valid = true;
+  }
+
+  const uint16_t off = (uint16_t) ( seq - ctx->rcv_nxt );
+  const bool owed = ctx->ack_owed;
+  ctx->ack_owed = true;
+
+  if( MIXLINK_ARQ_WINDOW_MAX > off && MIXLINK_ARQ_MAX_SEGMENT >= len ){
+    arq_hold_t * hold = &ctx->rcv[ seq & ARQ_WINDOW_MASK ];
+    if( !hold->have ){
+      (void) memcpy( hold->val, val, len );
+      hold->len = (uint16_t) len;
+      hold->have = true;
+    }
+    arq_drain( ctx, abi, n );
+  }
+
+  // In order data waits for reverse traffic, a gap or a duplicate is reported at once
+  if( !abi->wake_reverse )
+    return;
+  if( off )
+    (void) abi->wake_reverse( abi->wake_reverse_ctx, 0 );
+  else if( !owed )
+    (void) abi->wake_reverse( abi->wake_reverse_ctx, ctx->delay );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_sr_init(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  if( def->priv )
+    return 0;
+
+  const long window = mixlink_abi_arg( def->args, "window", MIXLINK_ARQ_WINDOW );
+  const long delay  = mixlink_abi_arg( def->args, "delay", MIXLINK_ARQ_DELAY_MS );
+  const long adapt  = mixlink_abi_arg( def->args, "adapt", 0 );
+  if( 1 > window || MIXLINK_ARQ_WINDOW_MAX < window || 0 > delay ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  arq_ctx_t * ctx = calloc( 1, sizeof(arq_ctx_t) );
+  if( !ctx )
+    return -1;
+
+  const int ret = pthread_mutex_init( &ctx->lock, NULL );
+  if( 0 != ret ){
+    free( ctx );
+    errno = ret;
+    return -1;
+  }
+
+  ctx->window = (uint16_t) window;
+  ctx->delay  = (uint32_t) delay;
+  ctx->adapt  = ( 0 != adapt );
+  ctx->rto    = MIXLINK_ARQ_RTO_INIT_MS;
+
+  // A random first sequence number, so a restarted sender lands far from where the receiver stands and its SYNC resets it
+  uint16_t isn;
+  if( sizeof(isn) != getrandom( &isn, sizeof(isn), GRND_NONBLOCK ) )
+    isn = (uint16_t) ( arq_now( ) ^ (uint64_t) (uintptr_t) ctx );
+  ctx->snd_una = ctx->snd_nxt = ctx->snd_end = isn;
+
+  def->priv = ctx;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_sr_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  arq_ctx_t * ctx = (arq_ctx_t *) def->priv;
+  if( ctx ){
+    (void) pthread_mutex_destroy( &ctx->lock );
+    free( ctx );
+  }
+
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_sr_tx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  arq_ctx_t * ctx = (arq_ctx_t *) abi->priv;
+  uint8_t n = 0;
+
+  (void) pthread_mutex_lock( &ctx->lock );
+
+  if( abi->n_in ){
+    const mixlink_buf8_t * in = abi->in[0];
+    int err = 0;
+    if( MIXLINK_ARQ_MAX_SEGMENT < in->len )
+      err = EMSGSIZE;
+    else if( MIXLINK_ARQ_QUEUE <= (uint16_t) ( ctx->snd_end - ctx->snd_una ) )
+      err = ENOBUFS;
+
+    if( err ){
+      abi->full = ( ENOBUFS == err );
+      (void) pthread_mutex_unlock( &ctx->lock );
+      errno = err;
+      return -1;
+    }
+
+    arq_slot_t * slot = &ctx->snd[ ctx->snd_end ++ & ARQ_QUEUE_MASK ];
+    (void) memcpy( slot->val, in->val, in->len );
+    slot->len     = (uint16_t) in->len;
+    slot->sacked  = false;
+    slot->lost    = false;
+    slot->retries = 0;
+    slot->sent    = 0;
+  }
+
+  arq_pump( ctx, abi, &n );
+
+  // The core stops feeding a full queue, the receiver kicks this side once an acknowledgement frees room
+  abi->full = ( MIXLINK_ARQ_QUEUE <= (uint16_t) ( ctx->snd_end - ctx->snd_una ) );
+
+  (void) pthread_mutex_unlock( &ctx->lock );
+
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_sr_rx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  arq_ctx_t * ctx = (arq_ctx_t *) abi->priv;
+  uint8_t n = 0;
+
+  (void) pthread_mutex_lock( &ctx->lock );
+
+  // A kick only delivers what the reorder buffer still holds
+  if( !abi->n_in ){
+    if( ctx->rcv_valid )
+      arq_drain( ctx, abi, &n );
+    (void) pthread_mutex_unlock( &ctx->lock );
+    abi->n_out = n;
+    return n ? 0 : 1;
+  }
+
+  const mixlink_buf8_t * in = abi->in[0];
+  const uint8_t flags = in->len ? in->val[0] : 0;
+  const size_t bytes = flags >> 4;
+  const size_t need = 1u + ( ( MIXLINK_ARQ_DATA & flags ) ? 2u : 0u ) + ( ( MIXLINK_ARQ_ACK & flags ) ? 2u + bytes : 0u );
+  if( !in->len || in->len < need || 8 < bytes ){
+    (void) pthread_mutex_unlock( &ctx->lock );
+    errno = EBADMSG;
+    return -1;
+  }
+
+  size_t at = 1;
+  uint16_t seq = 0;
+  if( MIXLINK_ARQ_DATA & flags ){
+    seq = (uint16_t) ( in->val[ at ] | in->val[ at + 1 ] << 8 );
+    at += 2;
+  }
+
+  if( MIXLINK_ARQ_ACK & flags ){
+    const uint16_t ack = (uint16_t) ( in->val[ at ] | in->val[ at + 1 ] << 8 );
+    uint64_t sack = 0;
+    for( size_t i = 0 ; i < bytes ; ++i )
+      sack |= (uint64_t) in->val[ at + 2 + i ] << ( 8 * i );
+    at += 2 + bytes;
+
+    // Room in the window or a loss to repair, the sender has work
+    if( arq_on_ack( ctx, ack, sack, abi->link ) && abi->wake_reverse )
+      (void) abi->wake_reverse( abi->wake_reverse_ctx, 0 );
+  }
+
+  if( MIXLINK_ARQ_DATA & flags )
+    arq_on_data( ctx, abi, &n, seq, MIXLINK_ARQ_SYNC & flags, &in->val[ at ], in->len - at );
+
+  (void) pthread_mutex_unlock( &ctx->lock );
+
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,74 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      builtin.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Registry of the stack modules linked into the binary.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <string.h>
+#include <errno.h>
+
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Lookup tables
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define X( n, i, r, t, d ) \
+  {                       \
+    .name    = #n,        \
+    .version = 1,         \
+    .init    = i,         \
+    .rx      = r,         \
+    .tx      = t,         \
+    .deinit  = d,         \
+  },
+static const mixlink_builtin_t builtin_modules[ ] = {
+  MIXLINK_BUILTIN_MODULES
+};
+#undef X
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+const mixlink_builtin_t *
+mixlink_builtin_find(
+  const char * name
+){
+  if( !name ){
+    errno = EINVAL;
+    return NULL;
+  }
+
+  for( size_t i = 0 ; i < sizeof(builtin_modules) / sizeof(builtin_modules[0]) ; ++i )
+    if( 0 == strcmp( builtin_modules[i].name, name ) )
+      return &builtin_modules[i];
+
+  errno = ENOENT;
+  return NULL;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
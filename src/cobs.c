@@ -0,0 +1,651 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      cobs.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Consistent Overhead Byte Stuffing (COBS) and COBS/R codec, and the `builtin:cobs` and `builtin:cobsr` framers.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: S. Cheshire and M. Baker, "Consistent Overhead Byte Stuffing", IEEE/ACM ToN, 1999.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(__x86_64__) && defined(__SSE2__)
+#include <immintrin.h>
+#define COBS_X86 1
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#define COBS_NEON 1
+#endif
+
+#include "cobs.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+typedef size_t (* cobs_scan_fn_t)(
+  const uint8_t * src,
+  const size_t len
+);
+
+//!< State of a deframer instance, only touched by the thread of the RX direction
+typedef struct{
+  mixlink_cobs_stream_t stream;
+  uint8_t frame[ MIXLINK_COBS_WINDOW ];                                        //!< The frame being decoded, it spans as many inputs as needed
+  uint8_t pending[ MIXLINK_COBS_WINDOW ];                                      //!< Input left once every output was used, decoded on the next call
+  size_t npending;
+  uint64_t frames;                                                             //!< Frames emitted
+  uint64_t errors;                                                             //!< Frames dropped, malformed, too long, or without room in the output
+} cobs_ctx_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+size_t cobs_scan_scalar(
+  const uint8_t * src,
+  const size_t len
+);
+
+size_t cobs_scan_resolve(
+  const uint8_t * src,
+  const size_t len
+);
+
+int8_t cobs_stream_close(
+  mixlink_cobs_stream_t * stream,
+  const bool cut
+);
+
+void cobs_stream_break(
+  mixlink_cobs_stream_t * stream,
+  const int err
+);
+
+int8_t cobs_tx(
+  void * arg,
+  const bool reduced
+);
+
+size_t cobs_drain(
+  cobs_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  const uint8_t * src,
+  const size_t len,
+  uint8_t * n
+);
+
+int8_t cobs_init(
+  void * arg,
+  const bool reduced
+);
+
+int8_t cobs_rx(
+  void * arg
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Global variables
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Resolved on the first scan, the codec may run before anything else is initialized, e.g., from a built-in module
+static cobs_scan_fn_t cobs_scan = cobs_scan_resolve;
+static const char * cobs_name = "scalar";
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * SIMD scans
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef COBS_X86
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+static size_t
+cobs_scan_sse2(
+  const uint8_t * src,
+  const size_t len
+){
+  const __m128i zero = _mm_setzero_si128( );
+  size_t i = 0;
+
+  for( ; i + 16 <= len ; i += 16 ){
+    const __m128i v = _mm_loadu_si128( (const __m128i *) &src[i] );
+    const unsigned mask = (unsigned) _mm_movemask_epi8( _mm_cmpeq_epi8( v, zero ) );
+    if( mask )
+      return i + (size_t) __builtin_ctz( mask );
+  }
+
+  return i + cobs_scan_scalar( &src[i], len - i );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+__attribute__(( target( "avx2" ) ))
+static size_t
+cobs_scan_avx2(
+  const uint8_t * src,
+  const size_t len
+){
+  const __m256i zero = _mm256_setzero_si256( );
+  size_t i = 0;
+
+  for( ; i + 32 <= len ; i += 32 ){
+    const __m256i v = _mm256_loadu_si256( (const __m256i *) &src[i] );
+    const unsigned mask = (unsigned) _mm256_movemask_epi8( _mm256_cmpeq_epi8( v, zero ) );
+    if( mask )
+      return i + (size_t) __builtin_ctz( mask );
+  }
+
+  return i + cobs_scan_sse2( &src[i], len - i );
+}
+#endif
+
+#ifdef COBS_NEON
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+static size_t
+cobs_scan_neon(
+  const uint8_t * src,
+  const size_t len
+){
+  size_t i = 0;
+
+  for( ; i + 16 <= len ; i += 16 ){
+    const uint8x16_t eq = vceqq_u8( vld1q_u8( &src[i] ), vdupq_n_u8( 0 ) );
+
+    // NEON has no movemask, narrowing keeps 4 bits per byte in a 64 bit lane
+    const uint8x8_t nibbles = vshrn_n_u16( vreinterpretq_u16_u8( eq ), 4 );
+    const uint64_t mask = vget_lane_u64( vreinterpret_u64_u8( nibbles ), 0 );
+    if( mask )
+      return i + (size_t) ( __builtin_ctzll( mask ) >> 2 );
+  }
+
+  return i + cobs_scan_scalar( &src[i], len - i );
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+cobs_scan_scalar(
+  const uint8_t * src,
+  const size_t len
+){
+  for( size_t i = 0 ; i < len ; ++i )
+    if( MIXLINK_COBS_DELIMITER == src[i] )
+      return i;
+
+  return len;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+cobs_scan_resolve(
+  const uint8_t * src,
+  const size_t len
+){
+  cobs_scan_fn_t fn = cobs_scan_scalar;
+  const char * name = "scalar";
+
+#ifdef COBS_X86
+  fn = cobs_scan_sse2;
+  name = "sse2";
+
+  __builtin_cpu_init( );
+  if( __builtin_cpu_supports( "avx2" ) ){
+    fn = cobs_scan_avx2;
+    name = "avx2";
+  }
+#endif
+
+#ifdef COBS_NEON
+  fn = cobs_scan_neon;
+  name = "neon";
+#endif
+
+  // Every thread resolves the same values, a race only repeats the work
+  __atomic_store_n( &cobs_name, name, __ATOMIC_RELAXED );
+  __atomic_store_n( &cobs_scan, fn, __ATOMIC_RELAXED );
+  return fn( src, len );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+mixlink_cobs_scan(
+  const uint8_t * src,
+  const size_t len
+){
+  return __atomic_load_n( &cobs_scan, __ATOMIC_RELAXED )( src, len );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+const char *
+mixlink_cobs_impl(
+  void
+){
+  if( cobs_scan_resolve == __atomic_load_n( &cobs_scan, __ATOMIC_RELAXED ) )
+    (void) cobs_scan_resolve( NULL, 0 );
+
+  return __atomic_load_n( &cobs_name, __ATOMIC_RELAXED );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+mixlink_cobs_encode(
+  const uint8_t * src,
+  const size_t len,
+  uint8_t * dst,
+  const bool reduced
+){
+  size_t code_at = 0;
+  size_t i = 0;
+  size_t o = 0;
+
+  // Each block is one scan for the next zero, up to 254 bytes ahead, and one copy
+  for( ; ; ){
+    const size_t run = ( len - i < 254 ) ? len - i : 254;
+    const size_t z = mixlink_cobs_scan( &src[i], run );
+
+    code_at = o;
+    dst[ o ++ ] = (uint8_t) ( z + 1 );
+    (void) memcpy( &dst[o], &src[i], z );
+    o += z;
+    i += z;
+
+    if( z < run ){
+      i ++;
+      continue;
+    }
+
+    // A full block is followed by another one, even if empty
+    if( 254 > z )
+      break;
+  }
+
+  const uint8_t code = dst[ code_at ];
+  if( reduced && 1 < code && code < dst[ o - 1 ] ){
+    dst[ code_at ] = dst[ o - 1 ];
+    o --;
+  }
+
+  return o;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+ptrdiff_t
+mixlink_cobs_decode(
+  const uint8_t * src,
+  const size_t len,
+  uint8_t * dst,
+  const size_t size,
+  const bool reduced
+){
+  mixlink_cobs_stream_t stream = { .reduced = reduced };
+  mixlink_cobs_stream_reset( &stream, dst, size );
+
+  size_t used = 0;
+  const int8_t ret = mixlink_cobs_stream_feed( &stream, src, len, &used );
+  if( -1 == ret )
+    return -1;
+
+  if( 1 == ret ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  if( -1 == mixlink_cobs_stream_end( &stream ) )
+    return -1;
+
+  return (ptrdiff_t) stream.len;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_cobs_stream_reset(
+  mixlink_cobs_stream_t * stream,
+  uint8_t * dst,
+  const size_t size
+){
+  stream->dst    = dst;
+  stream->size   = size;
+  stream->len    = 0;
+  stream->code   = 0;
+  stream->left   = 0;
+  stream->broken = false;
+  stream->err    = 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+cobs_stream_break(
+  mixlink_cobs_stream_t * stream,
+  const int err
+){
+  if( stream->broken )
+    return;
+
+  stream->broken = true;
+  stream->err = err;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+cobs_stream_close(
+  mixlink_cobs_stream_t * stream,
+  const bool cut
+){
+  // In COBS/R the code byte of a last block cut short is its last data byte
+  if( cut && !stream->reduced )
+    cobs_stream_break( stream, EBADMSG );
+  else if( cut && stream->size <= stream->len )
+    cobs_stream_break( stream, EMSGSIZE );
+  else if( cut && !stream->broken )
+    stream->dst[ stream->len ++ ] = stream->code;
+
+  stream->code = 0;
+  stream->left = 0;
+
+  if( stream->broken ){
+    errno = stream->err;
+    mixlink_cobs_stream_reset( stream, stream->dst, stream->size );
+    return -1;
+  }
+
+  return 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_cobs_stream_feed(
+  mixlink_cobs_stream_t * stream,
+  const uint8_t * src,
+  const size_t len,
+  size_t * used
+){
+  size_t i = 0;
+
+  while( i < len ){
+    if( stream->left ){
+      const size_t n = ( len - i < stream->left ) ? len - i : stream->left;
+      const size_t z = mixlink_cobs_scan( &src[i], n );
+
+      if( stream->size - stream->len < z )
+        cobs_stream_break( stream, EMSGSIZE );
+
+      if( !stream->broken ){
+        (void) memcpy( &stream->dst[ stream->len ], &src[i], z );
+        stream->len += z;
+      }
+
+      stream->left = (uint8_t) ( stream->left - z );
+      i += z;
+      if( z == n )
+        continue;
+
+      // The delimiter arrived before the block was complete
+      *used = i + 1;
+      return cobs_stream_close( stream, true );
+    }
+
+    const uint8_t code = src[ i ++ ];
+    if( MIXLINK_COBS_DELIMITER == code ){
+      if( !stream->code && !stream->broken )
+        continue;
+
+      *used = i;
+      return cobs_stream_close( stream, false );
+    }
+
+    // The zero implied by the previous block only exists if another block follows it
+    if( stream->code && 0xFF != stream->code ){
+      if( stream->size <= stream->len )
+        cobs_stream_break( stream, EMSGSIZE );
+      else if( !stream->broken )
+        stream->dst[ stream->len ++ ] = 0x00;
+    }
+
+    stream->code = code;
+    stream->left = (uint8_t) ( code - 1 );
+  }
+
+  *used = i;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_cobs_stream_end(
+  mixlink_cobs_stream_t * stream
+){
+  if( !stream->code && !stream->broken )
+    return 0;
+
+  return cobs_stream_close( stream, 0 != stream->left );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+cobs_tx(
+  void * arg,
+  const bool reduced
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+
+  if( out->size < MIXLINK_COBS_MAX_ENCODED( in->len ) + 1 ){
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  out->len = mixlink_cobs_encode( in->val, in->len, out->val, reduced );
+  out->val[ out->len ++ ] = MIXLINK_COBS_DELIMITER;
+
+  abi->n_out = 1;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+cobs_drain(
+  cobs_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  const uint8_t * src,
+  const size_t len,
+  uint8_t * n
+){
+  size_t at = 0;
+
+  while( at < len && *n < abi->n_out ){
+    size_t used = 0;
+    const int8_t ret = mixlink_cobs_stream_feed( &ctx->stream, &src[at], len - at, &used );
+    at += used;
+
+    if( -1 == ret )
+      ctx->errors ++;
+
+    if( 1 != ret )
+      continue;
+
+    mixlink_buf8_t * out = abi->out[ *n ];
+    if( out->size < ctx->stream.len )
+      ctx->errors ++;
+    else{
+      (void) memcpy( out->val, ctx->frame, ctx->stream.len );
+      out->len = ctx->stream.len;
+      ctx->frames ++;
+      ( *n ) ++;
+    }
+
+    mixlink_cobs_stream_reset( &ctx->stream, ctx->frame, sizeof(ctx->frame) );
+  }
+
+  return at;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+cobs_init(
+  void * arg,
+  const bool reduced
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  // A retried init keeps the frame in progress
+  if( def->priv )
+    return 0;
+
+  cobs_ctx_t * ctx = calloc( 1, sizeof(cobs_ctx_t) );
+  if( !ctx )
+    return -1;
+
+  ctx->stream.reduced = reduced;
+  mixlink_cobs_stream_reset( &ctx->stream, ctx->frame, sizeof(ctx->frame) );
+  def->priv = ctx;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+cobs_rx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  cobs_ctx_t * ctx = (cobs_ctx_t *) abi->priv;
+  uint8_t n = 0;
+
+  // Input held back by a previous call goes first, its bytes were never looked at
+  const size_t used = cobs_drain( ctx, abi, ctx->pending, ctx->npending, &n );
+  ctx->npending -= used;
+  (void) memmove( ctx->pending, &ctx->pending[ used ], ctx->npending );
+
+  if( abi->n_in ){
+    const mixlink_buf8_t * in = abi->in[0];
+    size_t at = 0;
+
+    if( !ctx->npending )
+      at = cobs_drain( ctx, abi, in->val, in->len, &n );
+
+    const size_t rest = in->len - at;
+    if( rest <= sizeof(ctx->pending) - ctx->npending ){
+      (void) memcpy( &ctx->pending[ ctx->npending ], &in->val[at], rest );
+      ctx->npending += rest;
+    }
+    else{
+      // The frame in progress loses bytes, it is dropped up to its delimiter
+      mixlink_cobs_stream_reset( &ctx->stream, ctx->frame, sizeof(ctx->frame) );
+      ctx->stream.broken = true;
+      ctx->stream.err = ENOBUFS;
+      ctx->errors ++;
+    }
+  }
+
+  if( ctx->npending && abi->wake )
+    (void) abi->wake( abi->wake_ctx, 0 );
+
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_cobs_init(
+  void * arg
+){
+  return cobs_init( arg, false );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_cobsr_init(
+  void * arg
+){
+  return cobs_init( arg, true );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_cobs_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  free( def->priv );
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_cobs_tx(
+  void * arg
+){
+  return cobs_tx( arg, false );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_cobs_rx(
+  void * arg
+){
+  return cobs_rx( arg );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_cobsr_tx(
+  void * arg
+){
+  return cobs_tx( arg, true );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_cobsr_rx(
+  void * arg
+){
+  return cobs_rx( arg );
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
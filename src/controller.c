@@ -26,8 +26,11 @@
 
 #include <string.h>
 #include <errno.h>
+#include <sys/uio.h>
+#include <sys/ioctl.h>
 
 #include "controller.h"
+#include "pool.h"
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * Local Prototypes
@@ -42,9 +45,10 @@ int8_t try_init_ser(
   mixlink_param_dev_t param
 );
 
-struct serial_handler * mixlink_controller_driver_pipeline_handler(
-  const enum direction dir, 
-  mixlink_controller_t * controller
+int8_t controller_reopen(
+  struct serial_handler * handler,
+  const uint32_t gen,
+  const uint16_t iterations
 );
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -89,6 +93,8 @@ try_init_ser(
 
   if( -1 != ret ){
     (void) memcpy( &ser->sr, &tmp, sizeof(serial_t) );
+    (void) pthread_rwlock_init( &ser->lock, NULL );
+    ser->gen = 0;
     ser->enabled = true;
 
     (void) mixlink_mod_load( 
@@ -96,6 +102,7 @@ try_init_ser(
       MIXLINK_STACK_SECTION_CONTROLLER_DRIVER,
       &ser->driver
     );
+    ser->cts = 0 != mixlink_abi_arg( ser->driver.def.args, "cts", 0 );
     return 0;
   }
 
@@ -103,6 +110,28 @@ try_init_ser(
 }
 
 
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t
+controller_reopen(
+  struct serial_handler * handler,
+  const uint32_t gen,
+  const uint16_t iterations
+){
+  // The other thread waits on the lock instead of using a descriptor being closed, and finds the port reopened
+  (void) pthread_rwlock_wrlock( &handler->lock );
+  int8_t ret = 0;
+  if( gen == handler->gen ){
+    ret = serial_reopen( &handler->sr, iterations );
+    if( -1 != ret )
+      (void) __atomic_add_fetch( &handler->gen, 1, __ATOMIC_RELEASE );
+  }
+  (void) pthread_rwlock_unlock( &handler->lock );
+
+  if( -1 == ret )
+    errno = ENODEV;
+  return ret;
+}
+
 /**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 int8_t 
 mixlink_controller_init( 
@@ -118,6 +147,8 @@ mixlink_controller_init(
     sizeof(mixlink_controller_t) 
   );
 
+  (void) mixlink_link_policy_init( &controller->policy, &controller->link );
+
   bool failed2ser = true;
 
   int8_t ret = try_init_ser(
@@ -139,6 +170,12 @@ mixlink_controller_init(
     return -1;
   }  
 
+  (void) mixlink_mod_load( 
+    param.sched, 
+    MIXLINK_STACK_SECTION_CONTROLLER_SCHED,
+    &controller->sched
+  );
+
   (void) mixlink_mod_load( 
     param.qos, 
     MIXLINK_STACK_SECTION_CONTROLLER_QOS,
@@ -157,6 +194,30 @@ mixlink_controller_init(
     &controller->segm
   );
 
+  (void) mixlink_mod_load( 
+    param.agg, 
+    MIXLINK_STACK_SECTION_CONTROLLER_AGG,
+    &controller->agg
+  );
+
+  (void) mixlink_mod_load( 
+    param.fec, 
+    MIXLINK_STACK_SECTION_CONTROLLER_FEC,
+    &controller->fec
+  );
+
+  (void) mixlink_mod_load( 
+    param.mac, 
+    MIXLINK_STACK_SECTION_CONTROLLER_MAC,
+    &controller->mac
+  );
+
+  (void) mixlink_mod_load( 
+    param.check, 
+    MIXLINK_STACK_SECTION_CONTROLLER_CHECK,
+    &controller->check
+  );
+
   return 0;
 }
 
@@ -179,13 +240,19 @@ mixlink_controller_close(
     if( iface[i]->enabled ){
       (void) serial_close( &iface[i]->sr );
       (void) mixlink_mod_unload( &iface[i]->driver );
+      (void) pthread_rwlock_destroy( &iface[i]->lock );
       iface[i]->enabled = false;
     }
   }
 
+  (void) mixlink_mod_unload( &controller->sched );
   (void) mixlink_mod_unload( &controller->segm );
   (void) mixlink_mod_unload( &controller->qos );
   (void) mixlink_mod_unload( &controller->framer );
+  (void) mixlink_mod_unload( &controller->agg );
+  (void) mixlink_mod_unload( &controller->fec );
+  (void) mixlink_mod_unload( &controller->mac );
+  (void) mixlink_mod_unload( &controller->check );
 
   return 0;
 }
@@ -201,33 +268,97 @@ mixlink_controller_write(
     return 0;
   }
 
-  serial_t * ser = NULL;
+  struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
+    MIXLINK_DIRECTION_FROM_NIC,
+    controller
+  );
 
-  if( controller->def.enabled )
-    ser = &controller->def.sr;
-  else if( controller->pair.tx.enabled )
-    ser = &controller->pair.tx.sr;
-  else{
+  if( !handler ){
     errno = EINVAL;
     return 0;
   }
 
-  size_t len = serial_write( 
-    ser,
-    data->val,
-    data->len
-  );
+  serial_t * ser = &handler->sr;
+  (void) pthread_rwlock_rdlock( &handler->lock );
+  const uint32_t gen = handler->gen;
+
+  size_t len = 0;
+  if( !data->n_frag )
+    len = serial_write( 
+      ser,
+      data->val,
+      data->len
+    );
+  else{
+    // Slices go out with one gather write, a partial write is completed piece by piece
+    struct iovec iov[ MIXLINK_BUF_MAX_IOV ];
+    const size_t niov = mixlink_buf8_iov( data, iov );
+    const ssize_t n = writev( ser->fd, iov, (int) niov );
+
+    if( 0 <= n || EAGAIN == errno ){
+      size_t skip = ( 0 < n ) ? (size_t) n : 0;
+      len = skip;
+      for( size_t i = 0 ; i < niov ; ++i ){
+        if( skip >= iov[i].iov_len ){
+          skip -= iov[i].iov_len;
+          continue;
+        }
+        const size_t rest = iov[i].iov_len - skip;
+        const size_t wr = serial_write( ser, (uint8_t *) iov[i].iov_base + skip, rest );
+        len += wr;
+        skip = 0;
+        if( wr != rest )
+          break;
+      }
+    }
+  }
+
+  const int err = errno;
+  (void) pthread_rwlock_unlock( &handler->lock );
+  errno = err;
 
   if( !len && ((errno == ENODEV) || (errno == EIO)) ){
     uint16_t iterations = 1e3;
-    if( -1 == serial_reopen( ser, iterations ) )
-      errno = ENODEV;
+    (void) controller_reopen( handler, gen, iterations );
   }
 
   return len;
 }
 
-/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+mixlink_controller_ready(
+  mixlink_controller_t * controller
+){
+  if( -1 == controller_valid( controller ) )
+    return false;
+
+  struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
+    MIXLINK_DIRECTION_FROM_NIC,
+    controller
+  );
+
+  if( !handler )
+    return true;
+
+  if( handler->ready )
+    return handler->ready( handler->ready_ctx );
+
+  if( !handler->cts )
+    return true;
+
+  // A line that cannot be read does not hold the writes back
+  int lines;
+  (void) pthread_rwlock_rdlock( &handler->lock );
+  const int ret = ioctl( handler->sr.fd, TIOCMGET, &lines );
+  (void) pthread_rwlock_unlock( &handler->lock );
+  if( -1 == ret )
+    return true;
+
+  return 0 != ( lines & TIOCM_CTS );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
 size_t 
 mixlink_controller_read( 
   mixlink_buf8_t * data,
@@ -240,34 +371,74 @@ mixlink_controller_read(
     return 0;
   }
 
-  serial_t * ser = NULL;
+  struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
+    MIXLINK_DIRECTION_TO_NIC,
+    controller
+  );
 
-  if( controller->def.enabled )
-    ser = &controller->def.sr;  
-  else if( controller->pair.rx.enabled )
-    ser = &controller->pair.rx.sr;
-  else{
+  if( !handler ){
     errno = EINVAL;
     return 0;
   }
 
+  (void) pthread_rwlock_rdlock( &handler->lock );
+
   size_t len = serial_read(
     (char *) &data->val[offset],
     data->size,
     0,
     total,
-    ser
+    &handler->sr
   );
 
-  if( !len && ((errno == ENODEV) || (errno == EIO)) ){
-    uint16_t iterations = 1e3;
-    if( -1 == serial_reopen( ser, iterations ) )
-      errno = ENODEV;
-  }
+  const int err = errno;
+  (void) pthread_rwlock_unlock( &handler->lock );
+  errno = err;
 
   return len;
 }
 
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int8_t
+mixlink_controller_reopen(
+  const enum direction dir,
+  mixlink_controller_t * controller,
+  const uint32_t gen,
+  const uint16_t iterations
+){
+  if( -1 == controller_valid( controller ) )
+    return -1;
+
+  struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
+    dir,
+    controller
+  );
+
+  if( !handler ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  return controller_reopen( handler, gen, iterations );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+uint32_t
+mixlink_controller_gen(
+  const enum direction dir,
+  mixlink_controller_t * controller
+){
+  if( -1 == controller_valid( controller ) )
+    return 0;
+
+  struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
+    dir,
+    controller
+  );
+
+  return handler ? __atomic_load_n( &handler->gen, __ATOMIC_ACQUIRE ) : 0;
+}
+
 /**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 struct serial_handler *
 mixlink_controller_driver_pipeline_handler(
@@ -290,15 +461,40 @@ mixlink_controller_driver_pipeline_handler(
   return NULL;
 }
 
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+int
+mixlink_controller_fd(
+  const enum direction dir, 
+  mixlink_controller_t * controller
+){
+  if( -1 == controller_valid( controller ) )
+    return -1;
+
+  struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
+    dir,
+    controller
+  );
+
+  if( !handler )
+    return -1;
+
+  (void) pthread_rwlock_rdlock( &handler->lock );
+  const int fd = handler->sr.fd;
+  (void) pthread_rwlock_unlock( &handler->lock );
+  return fd;
+}
+
 /**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 int8_t 
 mixlink_controller_driver_io(
-  mixlink_abi_gen_io_t data,
+  mixlink_abi_gen_io_t * data,
   const enum direction dir, 
   mixlink_controller_t * controller
 ){
-  if( -1 == controller_valid( controller ) )
+  if( -1 == controller_valid( controller ) || !data ){
+    errno = EINVAL;
     return -1;
+  }
 
   struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
     dir,
@@ -310,7 +506,9 @@ mixlink_controller_driver_io(
 
   mixlink_abi_io_serial_t abi;
   abi.sr = &( handler->sr ); 
-  abi.data = &( data );
+  abi.data = data;
+  abi.ready = handler->ready;
+  abi.ready_ctx = handler->ready_ctx;
 
   mixlink_callback_t * cb = NULL;
   if( dir == MIXLINK_DIRECTION_FROM_NIC )
@@ -322,10 +520,21 @@ mixlink_controller_driver_io(
   if( !cb )
     return -1;
 
-  return mixlink_mod_exec( 
+  (void) pthread_rwlock_rdlock( &handler->lock );
+  const int8_t ret = mixlink_mod_call( 
     (void *) &abi,
+    &( handler->driver ),
     cb
   );
+  (void) pthread_rwlock_unlock( &handler->lock );
+
+  // The hook outlives the call, the sink asks it before every write
+  if( dir == MIXLINK_DIRECTION_FROM_NIC ){
+    handler->ready = abi.ready;
+    handler->ready_ctx = abi.ready_ctx;
+  }
+
+  return ret;
 }
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -340,7 +549,8 @@ MIXLINK_CONTROLLER_MODULES
 #undef X
 
 #define X(name) \
-  MIXLINK_GEN_IO_MODULES_IMPL( controller, name, io, mixlink_controller_t )
+  MIXLINK_GEN_IO_MODULES_IMPL( controller, name, io, mixlink_controller_t ) \
+  MIXLINK_GEN_BATCH_MODULES_IMPL( controller, name, batch, mixlink_controller_t )
 MIXLINK_CONTROLLER_MODULES
 #undef X
 
@@ -360,10 +570,18 @@ MIXLINK_CONTROLLER_MODULES
     if( !handler ) return 0;                      \
     mixlink_abi_def_serial_t abi;                 \
     abi.sr = &( handler->sr );                    \
-    return mixlink_mod_exec(                      \
+    abi.def = handler->driver.def;                \
+    abi.radio = &( handler->radio );              \
+    (void) pthread_rwlock_rdlock( &handler->lock ); \
+    const int8_t ret = mixlink_mod_call(          \
       (void *) &abi,                              \
+      &( handler->driver ),                       \
       &( handler->driver.suffix )                 \
     );                                            \
+    (void) pthread_rwlock_unlock( &handler->lock ); \
+    handler->driver.def.caps = abi.def.caps;      \
+    handler->driver.def.priv = abi.def.priv;      \
+    return ret;                                   \
   } 
 
 #define X(suffix)  \
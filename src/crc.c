@@ -0,0 +1,363 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      crc.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     CRC32C and CRC16 checksums, and the `builtin:crc32c` and `builtin:crc16` integrity stages.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: RFC 3720 appendix B.4 (CRC32C), ITU-T V.41 (CRC16).
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define CRC_X86 1
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC_ARM 1
+#endif
+
+#include "crc.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define CRC32C_POLY 0x82F63B78u                                                //!< Castagnoli polynomial, reflected
+#define CRC16_POLY  0x1021u
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+typedef uint32_t (* crc32c_fn_t)(
+  uint32_t crc,
+  const uint8_t * src,
+  size_t len
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+void crc_setup(
+  void
+);
+
+uint32_t crc32c_slice8(
+  uint32_t crc,
+  const uint8_t * src,
+  size_t len
+);
+
+int8_t crc_tx(
+  void * arg,
+  const size_t width
+);
+
+int8_t crc_rx(
+  void * arg,
+  const size_t width
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Global variables
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+static pthread_once_t crc_once = PTHREAD_ONCE_INIT;
+static uint32_t crc32c_table[8][256];
+static uint16_t crc16_table[256];
+static crc32c_fn_t crc32c_fn = crc32c_slice8;
+static const char * crc_name = "slice-by-8";
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Hardware CRC
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef CRC_X86
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+__attribute__(( target( "sse4.2" ) ))
+static uint32_t
+crc32c_sse42(
+  uint32_t crc,
+  const uint8_t * src,
+  size_t len
+){
+  uint64_t c = crc;
+
+  for( ; len >= 8 ; len -= 8, src += 8 ){
+    uint64_t word;
+    (void) memcpy( &word, src, sizeof(word) );
+    c = _mm_crc32_u64( c, word );
+  }
+
+  uint32_t c32 = (uint32_t) c;
+  for( ; len ; --len, ++src )
+    c32 = _mm_crc32_u8( c32, *src );
+
+  return c32;
+}
+#endif
+
+#ifdef CRC_ARM
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+static uint32_t
+crc32c_armv8(
+  uint32_t crc,
+  const uint8_t * src,
+  size_t len
+){
+#if defined(__aarch64__)
+  for( ; len >= 8 ; len -= 8, src += 8 ){
+    uint64_t word;
+    (void) memcpy( &word, src, sizeof(word) );
+    crc = __crc32cd( crc, word );
+  }
+#endif
+
+  for( ; len >= 4 ; len -= 4, src += 4 ){
+    uint32_t word;
+    (void) memcpy( &word, src, sizeof(word) );
+    crc = __crc32cw( crc, word );
+  }
+
+  for( ; len ; --len, ++src )
+    crc = __crc32cb( crc, *src );
+
+  return crc;
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+crc_setup(
+  void
+){
+  for( uint32_t i = 0 ; i < 256 ; ++i ){
+    uint32_t c = i;
+    for( int k = 0 ; k < 8 ; ++k )
+      c = ( c & 1 ) ? ( c >> 1 ) ^ CRC32C_POLY : c >> 1;
+    crc32c_table[0][i] = c;
+
+    uint16_t h = (uint16_t) ( i << 8 );
+    for( int k = 0 ; k < 8 ; ++k )
+      h = (uint16_t) ( ( h & 0x8000 ) ? ( (uint32_t) h << 1 ) ^ CRC16_POLY : (uint32_t) h << 1 );
+    crc16_table[i] = h;
+  }
+
+  // Table k advances a byte that is followed by k more bytes
+  for( uint32_t i = 0 ; i < 256 ; ++i )
+    for( int k = 1 ; k < 8 ; ++k )
+      crc32c_table[k][i] = ( crc32c_table[k - 1][i] >> 8 ) ^ crc32c_table[0][ crc32c_table[k - 1][i] & 0xFF ];
+
+#ifdef CRC_X86
+  __builtin_cpu_init( );
+  if( __builtin_cpu_supports( "sse4.2" ) ){
+    crc32c_fn = crc32c_sse42;
+    crc_name = "sse4.2";
+  }
+#endif
+
+#ifdef CRC_ARM
+  crc32c_fn = crc32c_armv8;
+  crc_name = "armv8-crc";
+#endif
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint32_t
+crc32c_slice8(
+  uint32_t crc,
+  const uint8_t * src,
+  size_t len
+){
+  for( ; len >= 8 ; len -= 8, src += 8 ){
+    const uint32_t lo = crc ^ ( (uint32_t) src[0] | (uint32_t) src[1] << 8 | (uint32_t) src[2] << 16 | (uint32_t) src[3] << 24 );
+    crc = crc32c_table[7][ lo & 0xFF ] ^ crc32c_table[6][ ( lo >> 8 ) & 0xFF ] ^
+          crc32c_table[5][ ( lo >> 16 ) & 0xFF ] ^ crc32c_table[4][ lo >> 24 ] ^
+          crc32c_table[3][ src[4] ] ^ crc32c_table[2][ src[5] ] ^
+          crc32c_table[1][ src[6] ] ^ crc32c_table[0][ src[7] ];
+  }
+
+  for( ; len ; --len, ++src )
+    crc = ( crc >> 8 ) ^ crc32c_table[0][ ( crc ^ *src ) & 0xFF ];
+
+  return crc;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint32_t
+mixlink_crc32c(
+  const uint8_t * src,
+  const size_t len
+){
+  (void) pthread_once( &crc_once, crc_setup );
+  return ~crc32c_fn( 0xFFFFFFFFu, src, len );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint16_t
+mixlink_crc16(
+  const uint8_t * src,
+  const size_t len
+){
+  (void) pthread_once( &crc_once, crc_setup );
+
+  uint16_t crc = 0xFFFF;
+  for( size_t i = 0 ; i < len ; ++i )
+    crc = (uint16_t) ( ( crc << 8 ) ^ crc16_table[ ( crc >> 8 ) ^ src[i] ] );
+
+  return crc;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+const char *
+mixlink_crc_impl(
+  void
+){
+  (void) pthread_once( &crc_once, crc_setup );
+  return crc_name;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+crc_tx(
+  void * arg,
+  const size_t width
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+
+  if( out->size < in->len + width ){
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  (void) memcpy( out->val, in->val, in->len );
+  out->len = in->len;
+
+  const uint32_t crc = ( MIXLINK_CRC32C_LEN == width ) ?
+    mixlink_crc32c( in->val, in->len ) :
+    mixlink_crc16( in->val, in->len );
+
+  uint8_t * trailer = mixlink_buf8_put( out, width );
+  for( size_t i = 0 ; i < width ; ++i )
+    trailer[i] = (uint8_t) ( crc >> ( 8 * i ) );
+
+  abi->n_out = 1;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+crc_rx(
+  void * arg,
+  const size_t width
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+  bool good = false;
+
+  if( in->len >= width ){
+    const size_t len = in->len - width;
+    const uint32_t crc = ( MIXLINK_CRC32C_LEN == width ) ?
+      mixlink_crc32c( in->val, len ) :
+      mixlink_crc16( in->val, len );
+
+    uint32_t got = 0;
+    for( size_t i = 0 ; i < width ; ++i )
+      got |= (uint32_t) in->val[ len + i ] << ( 8 * i );
+
+    good = ( crc == got );
+  }
+
+  // The TX thread reads the counters, e.g., from the QoS stage
+  if( abi->link )
+    __atomic_fetch_add( good ? &abi->link->rx_good : &abi->link->rx_bad, 1, __ATOMIC_RELAXED );
+
+  // A corrupted frame is absorbed, it never reaches the reassembly
+  if( !good ){
+    abi->n_out = 0;
+    return 1;
+  }
+
+  // The payload is handed over as a slice, without a copy
+  out->len = 0;
+  (void) mixlink_buf8_link( out, in->val, in->len - width );
+  abi->n_out = 1;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_crc32c_tx(
+  void * arg
+){
+  return crc_tx( arg, MIXLINK_CRC32C_LEN );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_crc32c_rx(
+  void * arg
+){
+  return crc_rx( arg, MIXLINK_CRC32C_LEN );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_crc16_tx(
+  void * arg
+){
+  return crc_tx( arg, MIXLINK_CRC16_LEN );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_crc16_rx(
+  void * arg
+){
+  return crc_rx( arg, MIXLINK_CRC16_LEN );
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
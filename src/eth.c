@@ -0,0 +1,230 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      eth.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Ethernet header elision of the `builtin:eth` mac stage, learns the address pairs and ethertypes sent over the link.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: IEEE 802.3 clause 3 (MAC frame format).
+ *
+ *            The sender keeps a small table of the headers it has seen, a header already in the table goes over the link as
+ *            its index, a new one is sent in full and takes the entry used least recently. The receiver copies the headers
+ *            it is sent in full into its own table at the index given, so both tables match without feedback as long as
+ *            the refreshes arrive.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "eth.h"
+#include "crc.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< A header, the sender and the receiver hold the same one for the same identifier
+typedef struct{
+  bool valid;
+  uint8_t hdr[ MIXLINK_ETH_HDR ];
+  uint8_t check;                                                               //!< Low byte of the CRC32C of `hdr`, sent with each elided header
+  uint32_t count;                                                              //!< Elided headers since the context was last sent in full
+  uint64_t used;                                                               //!< Sender tick of the last frame, the least recent is replaced
+} eth_ctx_t;
+
+typedef struct{
+  uint64_t tick;
+  eth_ctx_t tx[ MIXLINK_ETH_CONTEXTS ];
+  eth_ctx_t rx[ MIXLINK_ETH_CONTEXTS ];
+} eth_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_eth_init(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  if( def->priv )
+    return 0;
+
+  def->priv = calloc( 1, sizeof(eth_t) );
+  return def->priv ? 0 : -1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_eth_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  free( def->priv );
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_eth_tx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  eth_t * eth = (eth_t *) abi->priv;
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+  if( out->size < in->len + MIXLINK_ETH_ELIDED ){
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  abi->n_out = 1;
+  if( MIXLINK_ETH_HDR > in->len ){
+    out->val[0] = MIXLINK_ETH_RAW;
+    (void) memcpy( &out->val[1], in->val, in->len );
+    out->len = in->len + 1;
+    return 0;
+  }
+
+  // The table is a few entries long, a linear search beats hashing the header
+  uint8_t cid = 0;
+  bool hit = false;
+  for( uint8_t i = 0 ; i < MIXLINK_ETH_CONTEXTS ; ++i ){
+    const eth_ctx_t * c = &eth->tx[i];
+    if( c->valid && !memcmp( c->hdr, in->val, MIXLINK_ETH_HDR ) ){
+      cid = i;
+      hit = true;
+      break;
+    }
+    if( eth->tx[ cid ].valid && ( !c->valid || c->used < eth->tx[ cid ].used ) )
+      cid = i;
+  }
+
+  eth_ctx_t * ctx = &eth->tx[ cid ];
+  ctx->used = ++ eth->tick;
+
+  if( hit && MIXLINK_ETH_REFRESH > ctx->count ){
+    out->val[0] = cid;
+    out->val[1] = ctx->check;
+    (void) memcpy( &out->val[ MIXLINK_ETH_ELIDED ], &in->val[ MIXLINK_ETH_HDR ], in->len - MIXLINK_ETH_HDR );
+    out->len = in->len - MIXLINK_ETH_HDR + MIXLINK_ETH_ELIDED;
+    ++ ctx->count;
+    return 0;
+  }
+
+  out->val[0] = MIXLINK_ETH_IR;
+  out->val[1] = cid;
+  (void) memcpy( &out->val[2], in->val, in->len );
+  out->len = in->len + 2;
+  ctx->valid = true;
+  ctx->count = 0;
+  ctx->check = (uint8_t) mixlink_crc32c( in->val, MIXLINK_ETH_HDR );
+  (void) memcpy( ctx->hdr, in->val, MIXLINK_ETH_HDR );
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_eth_rx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  eth_t * eth = (eth_t *) abi->priv;
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+  if( !in->len || out->size + 1 < in->len ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  const uint8_t type = in->val[0];
+  abi->n_out = 1;
+
+  if( MIXLINK_ETH_RAW == type ){
+    (void) memcpy( out->val, &in->val[1], in->len - 1 );
+    out->len = in->len - 1;
+    return 0;
+  }
+
+  if( MIXLINK_ETH_IR == type ){
+    if( in->len < MIXLINK_ETH_HDR + 2 || MIXLINK_ETH_CONTEXTS <= in->val[1] ){
+      errno = EBADMSG;
+      return -1;
+    }
+
+    eth_ctx_t * ctx = &eth->rx[ in->val[1] ];
+    ctx->valid = true;
+    ctx->check = (uint8_t) mixlink_crc32c( &in->val[2], MIXLINK_ETH_HDR );
+    (void) memcpy( ctx->hdr, &in->val[2], MIXLINK_ETH_HDR );
+    (void) memcpy( out->val, &in->val[2], in->len - 2 );
+    out->len = in->len - 2;
+    return 0;
+  }
+
+  // Until its header is sent again, a frame of a context never set up has no destination
+  if( MIXLINK_ETH_CONTEXTS <= type || !eth->rx[ type ].valid ){
+    errno = ENOENT;
+    return -1;
+  }
+
+  // The sender replaced the context and its new header was lost, the old one would send the frame to the wrong host
+  if( MIXLINK_ETH_ELIDED > in->len || in->val[1] != eth->rx[ type ].check ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  if( out->size < in->len - MIXLINK_ETH_ELIDED + MIXLINK_ETH_HDR ){
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  (void) memcpy( out->val, eth->rx[ type ].hdr, MIXLINK_ETH_HDR );
+  (void) memcpy( &out->val[ MIXLINK_ETH_HDR ], &in->val[ MIXLINK_ETH_ELIDED ], in->len - MIXLINK_ETH_ELIDED );
+  out->len = in->len - MIXLINK_ETH_ELIDED + MIXLINK_ETH_HDR;
+  return 0;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,766 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      fec.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     GF(256) arithmetic and the `builtin:rs` forward error correction stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: L. Rizzo, "Effective Erasure Codes for Reliable Computer Communication Protocols", ACM CCR, 1997.
+ *
+ *            Source segments are sent as they arrive with a header, the code is systematic. Once `k` of them are sent, or
+ *            `hold` ms after the first one, `m` repair segments follow, each one a combination of the whole block with
+ *            the coefficients of a Cauchy matrix, so any `k` segments of the block rebuild the missing sources.
+ *            A source is taken as its length in 2 bytes followed by its data, padded with zeros to the longest one.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define FEC_X86 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FEC_NEON 1
+#endif
+
+#include "fec.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define FEC_POLY   0x11D
+#define FEC_STRIDE ( 2 + MIXLINK_FEC_MAX_SYMBOL )                              //!< Length prefix and data of the longest symbol
+#define FEC_RX_QUEUE ( 2 * MIXLINK_FEC_MAX_M )                                 //!< Rebuilt sources waiting for an output, power of two
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+typedef void (* gf_madd_fn_t)(
+  uint8_t * dst,
+  const uint8_t * src,
+  const uint8_t c,
+  const size_t len
+);
+
+//!< State of an instance, TX and RX are only touched by the thread of their direction
+typedef struct{
+  uint8_t k;
+  uint8_t m;
+  uint32_t hold;
+  bool adapt;                                                                  //!< `m` follows the `fec_m` of the link policy, argument `adapt`
+
+  uint8_t tx_block;                                                            //!< Block being filled
+  uint8_t tx_n;                                                                //!< Sources in it
+  size_t tx_sym;                                                               //!< Longest symbol in it
+  uint8_t tx_src[ MIXLINK_FEC_MAX_K ][ FEC_STRIDE ];
+  uint8_t tx_rep[ MIXLINK_FEC_MAX_M ][ MIXLINK_FEC_HDR + FEC_STRIDE ];       //!< Repairs of the last closed block, ready to send
+  size_t tx_rep_len;
+  uint8_t tx_rep_next;
+  uint8_t tx_rep_n;
+  uint8_t tx_armed;                                                            //!< Block whose `hold` wake is pending
+
+  bool rx_open;
+  uint8_t rx_block;
+  uint8_t rx_k;                                                                //!< Sources of the block, known once a repair arrives
+  uint8_t rx_m;
+  bool rx_done;                                                                //!< Every source of the block is known, later repairs are ignored
+  uint64_t rx_seen;                                                            //!< Positions of the block that arrived, sources then repairs
+  uint32_t rx_src_have;
+  uint16_t rx_rep_have;
+  size_t rx_sym;
+  uint8_t rx_src[ MIXLINK_FEC_MAX_K ][ FEC_STRIDE ];
+  uint8_t rx_rep[ MIXLINK_FEC_MAX_M ][ FEC_STRIDE ];
+
+  uint8_t rx_out[ FEC_RX_QUEUE ][ FEC_STRIDE ];                                //!< Sources rebuilt and not handed out yet, the next stage had no room for them
+  uint8_t rx_out_head;
+  uint8_t rx_out_tail;
+
+  uint64_t recovered;                                                          //!< Sources rebuilt from repairs
+} fec_ctx_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+void fec_setup(
+  void
+);
+
+void gf_madd_scalar(
+  uint8_t * dst,
+  const uint8_t * src,
+  const uint8_t c,
+  const size_t len
+);
+
+uint8_t fec_coef(
+  const uint8_t j,
+  const uint8_t i
+);
+
+void fec_tx_close(
+  fec_ctx_t * ctx
+);
+
+void fec_tx_repairs(
+  fec_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n,
+  const uint8_t keep
+);
+
+int8_t fec_invert(
+  uint8_t * a,
+  const uint8_t e
+);
+
+void fec_rx_recover(
+  fec_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi
+);
+
+void fec_rx_deliver(
+  fec_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n,
+  const uint8_t keep
+);
+
+void fec_rx_observe(
+  fec_ctx_t * ctx,
+  mixlink_abi_link_t * link
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Global variables
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+static pthread_once_t fec_once = PTHREAD_ONCE_INIT;
+static uint8_t gf_exp[ 510 ];
+static uint8_t gf_log[ 256 ];
+static uint8_t gf_table[ 256 ][ 256 ];
+static gf_madd_fn_t gf_madd = gf_madd_scalar;
+static const char * fec_name = "table";
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * SIMD region multiplication
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#ifdef FEC_X86
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+__attribute__(( target( "ssse3" ) ))
+static void
+gf_madd_ssse3(
+  uint8_t * dst,
+  const uint8_t * src,
+  const uint8_t c,
+  const size_t len
+){
+  // A product is the sum of the products of both nibbles, each one a lookup in a 16 entry table
+  uint8_t lo[16], hi[16];
+  for( uint8_t i = 0 ; i < 16 ; ++i ){
+    lo[i] = gf_table[c][i];
+    hi[i] = gf_table[c][ i << 4 ];
+  }
+
+  const __m128i tlo  = _mm_loadu_si128( (const __m128i *) lo );
+  const __m128i thi  = _mm_loadu_si128( (const __m128i *) hi );
+  const __m128i mask = _mm_set1_epi8( 0x0F );
+
+  size_t i = 0;
+  for( ; i + 16 <= len ; i += 16 ){
+    const __m128i v = _mm_loadu_si128( (const __m128i *) &src[i] );
+    const __m128i l = _mm_shuffle_epi8( tlo, _mm_and_si128( v, mask ) );
+    const __m128i h = _mm_shuffle_epi8( thi, _mm_and_si128( _mm_srli_epi64( v, 4 ), mask ) );
+    const __m128i d = _mm_loadu_si128( (const __m128i *) &dst[i] );
+    _mm_storeu_si128( (__m128i *) &dst[i], _mm_xor_si128( d, _mm_xor_si128( l, h ) ) );
+  }
+
+  gf_madd_scalar( &dst[i], &src[i], c, len - i );
+}
+#endif
+
+#ifdef FEC_NEON
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+static void
+gf_madd_neon(
+  uint8_t * dst,
+  const uint8_t * src,
+  const uint8_t c,
+  const size_t len
+){
+  uint8_t lo[16], hi[16];
+  for( uint8_t i = 0 ; i < 16 ; ++i ){
+    lo[i] = gf_table[c][i];
+    hi[i] = gf_table[c][ i << 4 ];
+  }
+
+  const uint8x16_t tlo  = vld1q_u8( lo );
+  const uint8x16_t thi  = vld1q_u8( hi );
+  const uint8x16_t mask = vdupq_n_u8( 0x0F );
+
+  size_t i = 0;
+  for( ; i + 16 <= len ; i += 16 ){
+    const uint8x16_t v = vld1q_u8( &src[i] );
+    const uint8x16_t l = vqtbl1q_u8( tlo, vandq_u8( v, mask ) );
+    const uint8x16_t h = vqtbl1q_u8( thi, vshrq_n_u8( v, 4 ) );
+    vst1q_u8( &dst[i], veorq_u8( vld1q_u8( &dst[i] ), veorq_u8( l, h ) ) );
+  }
+
+  gf_madd_scalar( &dst[i], &src[i], c, len - i );
+}
+#endif
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+fec_setup(
+  void
+){
+  unsigned x = 1;
+  for( unsigned i = 0 ; i < 255 ; ++i ){
+    gf_exp[i] = gf_exp[ i + 255 ] = (uint8_t) x;
+    gf_log[x] = (uint8_t) i;
+    x <<= 1;
+    if( x & 0x100 )
+      x ^= FEC_POLY;
+  }
+
+  for( unsigned a = 1 ; a < 256 ; ++a )
+    for( unsigned b = 1 ; b < 256 ; ++b )
+      gf_table[a][b] = gf_exp[ gf_log[a] + gf_log[b] ];
+
+#ifdef FEC_X86
+  __builtin_cpu_init( );
+  if( __builtin_cpu_supports( "ssse3" ) ){
+    gf_madd = gf_madd_ssse3;
+    fec_name = "ssse3";
+  }
+#endif
+
+#ifdef FEC_NEON
+  gf_madd = gf_madd_neon;
+  fec_name = "neon";
+#endif
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint8_t
+mixlink_gf_mul(
+  const uint8_t a,
+  const uint8_t b
+){
+  (void) pthread_once( &fec_once, fec_setup );
+  return gf_table[a][b];
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint8_t
+mixlink_gf_inv(
+  const uint8_t a
+){
+  (void) pthread_once( &fec_once, fec_setup );
+  return a ? gf_exp[ 255 - gf_log[a] ] : 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+gf_madd_scalar(
+  uint8_t * dst,
+  const uint8_t * src,
+  const uint8_t c,
+  const size_t len
+){
+  const uint8_t * row = gf_table[c];
+  for( size_t i = 0 ; i < len ; ++i )
+    dst[i] ^= row[ src[i] ];
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_gf_madd(
+  uint8_t * dst,
+  const uint8_t * src,
+  const uint8_t c,
+  const size_t len
+){
+  (void) pthread_once( &fec_once, fec_setup );
+  if( c )
+    gf_madd( dst, src, c, len );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+const char *
+mixlink_fec_impl(
+  void
+){
+  (void) pthread_once( &fec_once, fec_setup );
+  return fec_name;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint8_t
+fec_coef(
+  const uint8_t j,
+  const uint8_t i
+){
+  // Cauchy matrix, rows and columns come from disjoint sets so every square submatrix is invertible
+  return mixlink_gf_inv( (uint8_t) ( ( MIXLINK_FEC_MAX_K + j ) ^ i ) );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+fec_tx_close(
+  fec_ctx_t * ctx
+){
+  const size_t sym = ctx->tx_sym;
+
+  for( uint8_t i = 0 ; i < ctx->tx_n ; ++i ){
+    const size_t len = 2 + ( (size_t) ctx->tx_src[i][0] | (size_t) ctx->tx_src[i][1] << 8 );
+    (void) memset( &ctx->tx_src[i][len], 0, sym - len );
+  }
+
+  for( uint8_t j = 0 ; j < ctx->m ; ++j ){
+    uint8_t * rep = ctx->tx_rep[j];
+    rep[0] = ctx->tx_block;
+    rep[1] = (uint8_t) ( ctx->tx_n + j );
+    rep[2] = ctx->tx_n;
+    rep[3] = ctx->m;
+
+    (void) memset( &rep[ MIXLINK_FEC_HDR ], 0, sym );
+    for( uint8_t i = 0 ; i < ctx->tx_n ; ++i )
+      mixlink_gf_madd( &rep[ MIXLINK_FEC_HDR ], ctx->tx_src[i], fec_coef( j, i ), sym );
+  }
+
+  ctx->tx_rep_len  = MIXLINK_FEC_HDR + sym;
+  ctx->tx_rep_next = 0;
+  ctx->tx_rep_n    = ctx->m;
+  ctx->tx_block ++;
+  ctx->tx_n   = 0;
+  ctx->tx_sym = 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+fec_tx_repairs(
+  fec_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n,
+  const uint8_t keep
+){
+  while( ctx->tx_rep_next < ctx->tx_rep_n && *n + keep < abi->n_out ){
+    mixlink_buf8_t * out = abi->out[ *n ];
+    if( out->size < ctx->tx_rep_len )
+      break;
+
+    (void) memcpy( out->val, ctx->tx_rep[ ctx->tx_rep_next ++ ], ctx->tx_rep_len );
+    out->len = ctx->tx_rep_len;
+    ( *n ) ++;
+  }
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+fec_invert(
+  uint8_t * a,
+  const uint8_t e
+){
+  uint8_t inv[ MIXLINK_FEC_MAX_M * MIXLINK_FEC_MAX_M ];
+  (void) memset( inv, 0, sizeof(inv) );
+  for( uint8_t i = 0 ; i < e ; ++i )
+    inv[ i * e + i ] = 1;
+
+  // Gauss-Jordan elimination, additions are XORs
+  for( uint8_t col = 0 ; col < e ; ++col ){
+    uint8_t piv = col;
+    while( piv < e && !a[ piv * e + col ] )
+      piv ++;
+    if( piv == e )
+      return -1;
+
+    for( uint8_t k = 0 ; k < e && piv != col ; ++k ){
+      uint8_t t = a[ col * e + k ];   a[ col * e + k ] = a[ piv * e + k ];     a[ piv * e + k ] = t;
+      t = inv[ col * e + k ];         inv[ col * e + k ] = inv[ piv * e + k ]; inv[ piv * e + k ] = t;
+    }
+
+    const uint8_t scale = mixlink_gf_inv( a[ col * e + col ] );
+    for( uint8_t k = 0 ; k < e ; ++k ){
+      a[ col * e + k ]   = mixlink_gf_mul( a[ col * e + k ], scale );
+      inv[ col * e + k ] = mixlink_gf_mul( inv[ col * e + k ], scale );
+    }
+
+    for( uint8_t r = 0 ; r < e ; ++r ){
+      const uint8_t f = a[ r * e + col ];
+      if( r == col || !f )
+        continue;
+      for( uint8_t k = 0 ; k < e ; ++k ){
+        a[ r * e + k ]   ^= mixlink_gf_mul( f, a[ col * e + k ] );
+        inv[ r * e + k ] ^= mixlink_gf_mul( f, inv[ col * e + k ] );
+      }
+    }
+  }
+
+  (void) memcpy( a, inv, (size_t) e * e );
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+fec_rx_recover(
+  fec_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi
+){
+  uint8_t lost[ MIXLINK_FEC_MAX_M ];
+  uint8_t reps[ MIXLINK_FEC_MAX_M ];
+  uint8_t e = 0;
+  uint8_t r = 0;
+
+  for( uint8_t i = 0 ; i < ctx->rx_k ; ++i )
+    if( !( ctx->rx_src_have & ( 1u << i ) ) ){
+      if( MIXLINK_FEC_MAX_M <= e )
+        return;
+      lost[ e ++ ] = i;
+    }
+
+  for( uint8_t j = 0 ; j < ctx->rx_m && r < e ; ++j )
+    if( ctx->rx_rep_have & ( 1u << j ) )
+      reps[ r ++ ] = j;
+
+  if( !e || r < e )
+    return;
+
+  // Each repair minus the sources received leaves a combination of the lost sources only
+  const size_t sym = ctx->rx_sym;
+  for( uint8_t q = 0 ; q < e ; ++q )
+    for( uint8_t i = 0 ; i < ctx->rx_k ; ++i )
+      if( ctx->rx_src_have & ( 1u << i ) )
+        mixlink_gf_madd( ctx->rx_rep[ reps[q] ], ctx->rx_src[i], fec_coef( reps[q], i ), sym );
+
+  uint8_t a[ MIXLINK_FEC_MAX_M * MIXLINK_FEC_MAX_M ];
+  for( uint8_t q = 0 ; q < e ; ++q )
+    for( uint8_t c = 0 ; c < e ; ++c )
+      a[ q * e + c ] = fec_coef( reps[q], lost[c] );
+
+  if( -1 == fec_invert( a, e ) )
+    return;
+
+  for( uint8_t c = 0 ; c < e ; ++c ){
+    uint8_t * src = ctx->rx_src[ lost[c] ];
+    (void) memset( src, 0, sym );
+    for( uint8_t q = 0 ; q < e ; ++q )
+      mixlink_gf_madd( src, ctx->rx_rep[ reps[q] ], a[ c * e + q ], sym );
+
+    ctx->rx_src_have |= 1u << lost[c];
+
+    // Queued, the outputs left in this call may not hold every source rebuilt
+    const size_t len = (size_t) src[0] | (size_t) src[1] << 8;
+    if( len + 2 > sym || FEC_RX_QUEUE == (uint8_t) ( ctx->rx_out_head - ctx->rx_out_tail ) )
+      continue;
+
+    (void) memcpy( ctx->rx_out[ ctx->rx_out_head ++ & ( FEC_RX_QUEUE - 1 ) ], src, len + 2 );
+    ctx->recovered ++;
+    if( abi->link )
+      __atomic_fetch_add( &abi->link->rx_recovered, 1, __ATOMIC_RELAXED );
+  }
+
+  ctx->rx_done = true;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+fec_rx_deliver(
+  fec_ctx_t * ctx,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n,
+  const uint8_t keep
+){
+  while( ctx->rx_out_tail != ctx->rx_out_head && *n + keep < abi->n_out ){
+    const uint8_t * src = ctx->rx_out[ ctx->rx_out_tail ++ & ( FEC_RX_QUEUE - 1 ) ];
+    const size_t len = (size_t) src[0] | (size_t) src[1] << 8;
+    mixlink_buf8_t * out = abi->out[ *n ];
+    if( out->size < len )
+      continue;
+
+    (void) memcpy( out->val, &src[2], len );
+    out->len = len;
+    ( *n ) ++;
+  }
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+fec_rx_observe(
+  fec_ctx_t * ctx,
+  mixlink_abi_link_t * link
+){
+  // Without a repair the size of the block is unknown, the positions up to the last one that arrived are counted
+  uint8_t size = (uint8_t) ( ctx->rx_k + ctx->rx_m );
+  if( !ctx->rx_k )
+    for( size = 0 ; size < 64 && ( ctx->rx_seen >> size ) ; ++size );
+
+  uint64_t lost = 0;
+  uint64_t bursts = 0;
+  bool gap = false;
+  for( uint8_t i = 0 ; i < size ; ++i ){
+    const bool miss = !( ( ctx->rx_seen >> i ) & 1u );
+    lost   += miss;
+    bursts += miss && !gap;
+    gap = miss;
+  }
+
+  mixlink_abi_link_observe( link, size, lost, bursts );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_rs_init(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  if( def->priv )
+    return 0;
+
+  const long k    = mixlink_abi_arg( def->args, "k", 8 );
+  const long m    = mixlink_abi_arg( def->args, "m", 2 );
+  const long hold = mixlink_abi_arg( def->args, "hold", MIXLINK_FEC_HOLD_MS );
+  const long adapt = mixlink_abi_arg( def->args, "adapt", 0 );
+  if( 1 > k || MIXLINK_FEC_MAX_K < k || 0 > m || MIXLINK_FEC_MAX_M < m || 0 > hold ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  fec_ctx_t * ctx = calloc( 1, sizeof(fec_ctx_t) );
+  if( !ctx )
+    return -1;
+
+  ctx->k    = (uint8_t) k;
+  ctx->m    = (uint8_t) m;
+  ctx->hold = (uint32_t) hold;
+  ctx->adapt = ( 0 != adapt );
+  def->priv = ctx;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_rs_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  free( def->priv );
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_rs_tx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  fec_ctx_t * ctx = (fec_ctx_t *) abi->priv;
+  const bool draining = ( ctx->tx_rep_next < ctx->tx_rep_n );
+  uint8_t n = 0;
+
+  // Repairs left by the previous calls go first, one output stays free for the input
+  fec_tx_repairs( ctx, abi, &n, abi->n_in ? 1 : 0 );
+
+  if( abi->n_in ){
+    const mixlink_buf8_t * in = abi->in[0];
+    mixlink_buf8_t * out = abi->out[ n ];
+    if( out->size < MIXLINK_FEC_HDR + in->len ){
+      errno = EMSGSIZE;
+      return -1;
+    }
+
+    const bool protect = ( MIXLINK_FEC_MAX_SYMBOL >= in->len );
+    out->val[0] = ctx->tx_block;
+    out->val[1] = protect ? ctx->tx_n : MIXLINK_FEC_UNPROTECTED;
+    out->val[2] = 0;
+    out->val[3] = 0;
+    (void) memcpy( &out->val[ MIXLINK_FEC_HDR ], in->val, in->len );
+    out->len = MIXLINK_FEC_HDR + in->len;
+    n ++;
+
+    if( protect ){
+      uint8_t * sym = ctx->tx_src[ ctx->tx_n ];
+      sym[0] = (uint8_t) in->len;
+      sym[1] = (uint8_t) ( in->len >> 8 );
+      (void) memcpy( &sym[2], in->val, in->len );
+      if( ctx->tx_sym < 2 + in->len )
+        ctx->tx_sym = 2 + in->len;
+
+      // The policy may change the repairs between blocks, never inside one
+      if( !ctx->tx_n && ctx->adapt && abi->link ){
+        const uint8_t m = __atomic_load_n( &abi->link->fec_m, __ATOMIC_RELAXED );
+        ctx->m = ( MIXLINK_FEC_MAX_M < m ) ? MIXLINK_FEC_MAX_M : m;
+        __atomic_store_n( &abi->link->fec_k, ctx->k, __ATOMIC_RELAXED );
+      }
+
+      // The deadline of an incomplete block starts with its first source
+      if( !ctx->tx_n && abi->wake ){
+        ctx->tx_armed = ctx->tx_block;
+        (void) abi->wake( abi->wake_ctx, ctx->hold );
+      }
+
+      if( ++ ctx->tx_n == ctx->k )
+        fec_tx_close( ctx );
+    }
+  }
+  else if( ctx->tx_n && ctx->tx_armed == ctx->tx_block ){
+    // A wake for the repairs of the previous block cannot be told from the deadline, the deadline is started again
+    if( !draining )
+      fec_tx_close( ctx );
+    else if( abi->wake )
+      (void) abi->wake( abi->wake_ctx, ctx->hold );
+  }
+
+  fec_tx_repairs( ctx, abi, &n, 0 );
+
+  if( ctx->tx_rep_next < ctx->tx_rep_n && abi->wake )
+    (void) abi->wake( abi->wake_ctx, 0 );
+
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_rs_rx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  fec_ctx_t * ctx = (fec_ctx_t *) abi->priv;
+  uint8_t n = 0;
+
+  // Sources rebuilt by the previous calls go first, one output stays free for the input
+  fec_rx_deliver( ctx, abi, &n, abi->n_in ? 1 : 0 );
+
+  if( !abi->n_in ){
+    if( ctx->rx_out_tail != ctx->rx_out_head && abi->wake )
+      (void) abi->wake( abi->wake_ctx, 0 );
+    abi->n_out = n;
+    return n ? 0 : 1;
+  }
+
+  const mixlink_buf8_t * in = abi->in[0];
+  if( MIXLINK_FEC_HDR > in->len ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  const uint8_t block = in->val[0];
+  const uint8_t idx   = in->val[1];
+  const uint8_t k     = in->val[2];
+  const uint8_t m     = in->val[3];
+  const uint8_t * payload = &in->val[ MIXLINK_FEC_HDR ];
+  const size_t len = in->len - MIXLINK_FEC_HDR;
+
+  // Segments of a block older than the current one are late, only their data is still useful
+  const bool stale = ctx->rx_open && block != ctx->rx_block && 128 > (uint8_t) ( ctx->rx_block - block );
+  if( !stale && ( !ctx->rx_open || block != ctx->rx_block ) ){
+    if( ctx->rx_open )
+      fec_rx_observe( ctx, abi->link );
+
+    ctx->rx_open     = true;
+    ctx->rx_done     = false;
+    ctx->rx_seen     = 0;
+    ctx->rx_block    = block;
+    ctx->rx_k        = 0;
+    ctx->rx_m        = 0;
+    ctx->rx_src_have = 0;
+    ctx->rx_rep_have = 0;
+  }
+
+  if( !k ){
+    mixlink_buf8_t * out = abi->out[ n ++ ];
+    if( out->size < len ){
+      errno = EMSGSIZE;
+      return -1;
+    }
+    (void) memcpy( out->val, payload, len );
+    out->len = len;
+
+    if( !stale && MIXLINK_FEC_MAX_K > idx && MIXLINK_FEC_MAX_SYMBOL >= len ){
+      uint8_t * sym = ctx->rx_src[ idx ];
+      sym[0] = (uint8_t) len;
+      sym[1] = (uint8_t) ( len >> 8 );
+      (void) memcpy( &sym[2], payload, len );
+      (void) memset( &sym[ 2 + len ], 0, FEC_STRIDE - 2 - len );
+      ctx->rx_src_have |= 1u << idx;
+      ctx->rx_seen |= (uint64_t) 1 << idx;
+    }
+  }
+  else if( !stale && !ctx->rx_done && MIXLINK_FEC_MAX_K >= k && MIXLINK_FEC_MAX_M >= m && idx >= k && idx - k < m && FEC_STRIDE >= len ){
+    const uint8_t j = (uint8_t) ( idx - k );
+    (void) memcpy( ctx->rx_rep[j], payload, len );
+    ctx->rx_rep_have |= (uint16_t) ( 1u << j );
+    ctx->rx_seen |= (uint64_t) 1 << idx;
+    ctx->rx_k   = k;
+    ctx->rx_m   = m;
+    ctx->rx_sym = len;
+  }
+
+  if( ctx->rx_k && !ctx->rx_done && !stale )
+    fec_rx_recover( ctx, abi );
+
+  fec_rx_deliver( ctx, abi, &n, 0 );
+
+  // The rest leaves on the next calls, the stage is kicked once the next ring has room
+  if( ctx->rx_out_tail != ctx->rx_out_head && abi->wake )
+    (void) abi->wake( abi->wake_ctx, 0 );
+
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
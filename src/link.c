@@ -0,0 +1,193 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      link.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Policy engine that retunes the redundancy of the FEC and the window of the ARQ from the loss measured on the serial link.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ *            Losses are modelled as bursts of a mean length `b`, so a block of `n` segments is seen as `n / b` slots lost
+ *            independently with the measured probability, and it is rebuilt while at most `m / b` slots are lost.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <string.h>
+#include <errno.h>
+
+#include "link.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+double link_fail(
+  const uint8_t k,
+  const uint8_t m,
+  const double loss,
+  const double burst
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+double
+link_fail(
+  const uint8_t k,
+  const uint8_t m,
+  const double loss,
+  const double burst
+){
+  if( 0 >= loss )
+    return 0;
+  if( 1 <= loss )
+    return 1;
+
+  const double span = (double) ( k + m ) / burst;
+  unsigned slots = (unsigned) span;
+  if( (double) slots < span )
+    slots ++;
+
+  const unsigned spare = (unsigned) ( (double) m / burst );
+  if( spare >= slots )
+    return 0;
+
+  // Binomial distribution of the lost slots, the block fails once more than `spare` are lost
+  double pmf = 1;
+  for( unsigned i = 0 ; i < slots ; ++i )
+    pmf *= 1 - loss;
+
+  double cdf = pmf;
+  for( unsigned i = 0 ; i < spare ; ++i ){
+    pmf *= (double) ( slots - i ) / (double) ( i + 1 ) * loss / ( 1 - loss );
+    cdf += pmf;
+  }
+
+  return ( 1 < cdf ) ? 0 : 1 - cdf;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_link_policy_init(
+  mixlink_link_policy_t * policy,
+  mixlink_abi_link_t * link
+){
+  if( !policy || !link ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  (void) memset( policy, 0, sizeof(mixlink_link_policy_t) );
+  policy->burst = 1;
+
+  __atomic_store_n( &link->fec_m, 0, __ATOMIC_RELAXED );
+  __atomic_store_n( &link->arq_window, MIXLINK_LINK_WINDOW_MAX, __ATOMIC_RELAXED );
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_link_policy_run(
+  mixlink_link_policy_t * policy,
+  mixlink_abi_link_t * link
+){
+  if( !policy || !link )
+    return;
+
+  const uint64_t seen   = __atomic_load_n( &link->rx_seen, __ATOMIC_RELAXED );
+  const uint64_t lost   = __atomic_load_n( &link->rx_lost, __ATOMIC_RELAXED );
+  const uint64_t bursts = __atomic_load_n( &link->rx_bursts, __ATOMIC_RELAXED );
+  const uint64_t good   = __atomic_load_n( &link->rx_good, __ATOMIC_RELAXED );
+  const uint64_t bad    = __atomic_load_n( &link->rx_bad, __ATOMIC_RELAXED );
+  const uint32_t peer   = __atomic_load_n( &link->peer_epoch, __ATOMIC_ACQUIRE );
+
+  double loss  = -1;
+  double burst = 1;
+
+  // The peer knows what happened to our frames, otherwise the FEC positions, otherwise the integrity check
+  if( peer != policy->peer_epoch ){
+    loss  = (double) __atomic_load_n( &link->peer_loss, __ATOMIC_RELAXED ) / 1e6;
+    burst = (double) __atomic_load_n( &link->peer_burst, __ATOMIC_RELAXED ) / 100;
+  }
+  else if( seen - policy->seen >= MIXLINK_LINK_MIN_SAMPLES ){
+    loss  = (double) ( lost - policy->lost ) / (double) ( seen - policy->seen );
+    burst = ( bursts - policy->bursts ) ? (double) ( lost - policy->lost ) / (double) ( bursts - policy->bursts ) : 1;
+  }
+  else if( ( good + bad ) - ( policy->good + policy->bad ) >= MIXLINK_LINK_MIN_SAMPLES )
+    loss = (double) ( bad - policy->bad ) / (double) ( ( good + bad ) - ( policy->good + policy->bad ) );
+
+  policy->seen       = seen;
+  policy->lost       = lost;
+  policy->bursts     = bursts;
+  policy->good       = good;
+  policy->bad        = bad;
+  policy->peer_epoch = peer;
+
+  if( 1 > burst )
+    burst = 1;
+
+  // A quarter of each sample, so a single bad period does not swing the code rate
+  if( 0 <= loss ){
+    if( !policy->primed ){
+      policy->loss  = loss;
+      policy->burst = burst;
+      policy->primed = true;
+    }
+    else{
+      policy->loss  += ( loss - policy->loss ) / 4;
+      policy->burst += ( burst - policy->burst ) / 4;
+    }
+  }
+
+  if( !policy->primed )
+    return;
+
+  const uint8_t k = __atomic_load_n( &link->fec_k, __ATOMIC_RELAXED );
+  const uint8_t block = k ? k : MIXLINK_LINK_DEFAULT_K;
+  const uint8_t was = __atomic_load_n( &link->fec_m, __ATOMIC_RELAXED );
+  const double target = (double) MIXLINK_LINK_TARGET_PPM / 1e6;
+
+  uint8_t m = 0;
+  while( MIXLINK_LINK_MAX_M > m && target < link_fail( block, m, policy->loss, policy->burst ) )
+    m ++;
+
+  // Redundancy rises at once and falls one repair per run, so a short calm does not strip the protection
+  if( m < was )
+    m = (uint8_t) ( was - 1 );
+
+  // Without an adaptive encoder every loss is left to the ARQ
+  const double left = k ? link_fail( block, m, policy->loss, policy->burst ) : policy->loss;
+  const uint16_t window = __atomic_load_n( &link->arq_window, __ATOMIC_RELAXED );
+  uint16_t next;
+  if( target < left )
+    next = ( MIXLINK_LINK_WINDOW_MIN * 2 < window ) ? (uint16_t) ( window / 2 ) : MIXLINK_LINK_WINDOW_MIN;
+  else
+    next = ( MIXLINK_LINK_WINDOW_MAX - MIXLINK_LINK_WINDOW_MAX / 8 > window ) ? (uint16_t) ( window + MIXLINK_LINK_WINDOW_MAX / 8 ) : MIXLINK_LINK_WINDOW_MAX;
+
+  __atomic_store_n( &link->loss, (uint32_t) ( policy->loss * 1e6 ), __ATOMIC_RELAXED );
+  __atomic_store_n( &link->burst, (uint32_t) ( policy->burst * 100 ), __ATOMIC_RELAXED );
+  __atomic_store_n( &link->fec_m, m, __ATOMIC_RELAXED );
+  __atomic_store_n( &link->arq_window, next, __ATOMIC_RELAXED );
+  __atomic_fetch_add( &link->epoch, 1, __ATOMIC_RELEASE );
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
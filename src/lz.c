@@ -0,0 +1,494 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      lz.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     LZ77 payload compressor with a preset dictionary of the `builtin:lz` comp stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: LZ4 block format description, Zstandard dictionary format (RFC 8878 section 5, raw content).
+ *
+ *            Frames of a few hundred bytes hold too little history to compress on their own, so both ends load the same
+ *            dictionary, e.g., samples of the telemetry sent, and every frame is compressed as if it followed it. The
+ *            match finder is a single hash table of 4-byte prefixes for the dictionary, built once, and another for the
+ *            frame, invalidated per frame by an epoch instead of being cleared. A frame is sent as is when it is shorter
+ *            than `min`, when the block would not be shorter, or, with `baud` given, while the time spent per byte exceeds
+ *            the airtime saved per byte; compression is retried every `MIXLINK_LZ_PROBE` frames so the estimates follow
+ *            the traffic. The search also stops at `budget`, or at the airtime of the frame, and the rest goes as literals.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+
+#include "lz.h"
+#include "crc.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define LZ_HASH_SIZE  ( 1u << MIXLINK_LZ_HASH_LOG )
+#define LZ_DIST_MAX   65535u
+#define LZ_BYTE_BITS  10u                                                      //!< Start, 8 data and stop bits of a byte on the serial line
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+typedef struct{
+  uint8_t dict[ MIXLINK_LZ_DICT_MAX ];
+  uint32_t dlen;
+  uint8_t id;                                                                  //!< Type of a block, `MIXLINK_LZ_BLOCK` and the dictionary
+  size_t min;                                                                  //!< Shortest frame compressed, argument `min`
+  uint64_t budget;                                                             //!< Most nanoseconds spent on a frame, argument `budget` in microseconds
+  double byte_ns;                                                              //!< Airtime of a byte, from the argument `baud`, 0 if unknown
+
+  uint32_t dtab[ LZ_HASH_SIZE ];                                               //!< Last dictionary position plus one of each hash, 0 if none
+  uint32_t ftab[ LZ_HASH_SIZE ];                                               //!< Last frame position of each hash, valid if `fepoch` matches
+  uint32_t fepoch[ LZ_HASH_SIZE ];
+  uint32_t epoch;
+
+  double cost;                                                                 //!< Smoothed nanoseconds spent per byte of input
+  double saved;                                                                //!< Smoothed share of the bytes saved
+  uint32_t skipped;                                                            //!< Frames sent as is since the last attempt
+} lz_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+uint64_t lz_now(
+  void
+);
+
+uint32_t lz_hash(
+  const uint8_t * at
+);
+
+int8_t lz_load(
+  lz_t * lz,
+  const char * path
+);
+
+uint8_t * lz_sequence(
+  uint8_t * op,
+  const uint8_t * end,
+  const uint8_t * lit,
+  const size_t nlit,
+  const size_t dist,
+  const size_t mlen
+);
+
+size_t lz_compress(
+  lz_t * lz,
+  const uint8_t * src,
+  const size_t n,
+  uint8_t * dst,
+  const size_t cap,
+  const uint64_t deadline
+);
+
+int8_t lz_decompress(
+  const lz_t * lz,
+  const uint8_t * src,
+  const size_t n,
+  uint8_t * dst,
+  const size_t cap,
+  size_t * len
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+lz_now(
+  void
+){
+  struct timespec ts;
+  (void) clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint32_t
+lz_hash(
+  const uint8_t * at
+){
+  uint32_t val;
+  (void) memcpy( &val, at, sizeof(val) );
+  return ( val * 2654435761u ) >> ( 32 - MIXLINK_LZ_HASH_LOG );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+lz_load(
+  lz_t * lz,
+  const char * path
+){
+  FILE * file = fopen( path, "rb" );
+  if( !file )
+    return -1;
+
+  // Matches nearer the frame are cheaper, so a long dictionary keeps its end
+  long size = -1;
+  if( 0 == fseek( file, 0, SEEK_END ) )
+    size = ftell( file );
+  const long skip = ( MIXLINK_LZ_DICT_MAX < size ) ? size - MIXLINK_LZ_DICT_MAX : 0;
+  if( 0 > size || 0 != fseek( file, skip, SEEK_SET ) ){
+    (void) fclose( file );
+    errno = EIO;
+    return -1;
+  }
+
+  lz->dlen = (uint32_t) fread( lz->dict, 1, (size_t) ( size - skip ), file );
+  (void) fclose( file );
+
+  for( uint32_t i = 0 ; i + MIXLINK_LZ_MIN_MATCH <= lz->dlen ; ++i )
+    lz->dtab[ lz_hash( &lz->dict[i] ) ] = i + 1;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint8_t *
+lz_sequence(
+  uint8_t * op,
+  const uint8_t * end,
+  const uint8_t * lit,
+  const size_t nlit,
+  const size_t dist,
+  const size_t mlen
+){
+  if( (size_t) ( end - op ) < 1 + nlit / 255 + 1 + nlit + 2 + mlen / 255 + 1 )
+    return NULL;
+
+  uint8_t * token = op ++;
+  *token = (uint8_t) ( ( 15 > nlit ? nlit : 15 ) << 4 );
+  for( size_t rest = nlit - 15 ; 15 <= nlit ; rest -= 255 ){
+    *op ++ = (uint8_t) ( 255 > rest ? rest : 255 );
+    if( 255 > rest )
+      break;
+  }
+
+  (void) memcpy( op, lit, nlit );
+  op += nlit;
+  if( !mlen )
+    return op;
+
+  *op ++ = (uint8_t) dist;
+  *op ++ = (uint8_t) ( dist >> 8 );
+
+  const size_t ml = mlen - MIXLINK_LZ_MIN_MATCH;
+  *token |= (uint8_t) ( 15 > ml ? ml : 15 );
+  for( size_t rest = ml - 15 ; 15 <= ml ; rest -= 255 ){
+    *op ++ = (uint8_t) ( 255 > rest ? rest : 255 );
+    if( 255 > rest )
+      break;
+  }
+
+  return op;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+lz_compress(
+  lz_t * lz,
+  const uint8_t * src,
+  const size_t n,
+  uint8_t * dst,
+  const size_t cap,
+  const uint64_t deadline
+){
+  const uint8_t * end = &dst[ cap ];
+  uint8_t * op = dst;
+  size_t ip = 0;
+  size_t anchor = 0;
+  uint32_t steps = 0;
+
+  if( !++ lz->epoch ){
+    (void) memset( lz->fepoch, 0, sizeof(lz->fepoch) );
+    lz->epoch = 1;
+  }
+
+  while( ip + MIXLINK_LZ_MIN_MATCH <= n ){
+    if( !( ++ steps & 63 ) && lz_now() > deadline )
+      break;
+
+    const uint32_t h = lz_hash( &src[ ip ] );
+    size_t best = 0;
+    size_t dist = 0;
+
+    if( lz->epoch == lz->fepoch[h] ){
+      const size_t at = lz->ftab[h];
+      size_t m = 0;
+      while( ip + m < n && src[ at + m ] == src[ ip + m ] )
+        ++ m;
+      if( MIXLINK_LZ_MIN_MATCH <= m && LZ_DIST_MAX >= ip - at ){
+        best = m;
+        dist = ip - at;
+      }
+    }
+
+    // A match in the dictionary stops at its end, the decoder could follow it into the frame but it is rarely longer
+    if( lz->dtab[h] ){
+      const size_t at = lz->dtab[h] - 1;
+      size_t m = 0;
+      while( at + m < lz->dlen && ip + m < n && lz->dict[ at + m ] == src[ ip + m ] )
+        ++ m;
+      if( MIXLINK_LZ_MIN_MATCH <= m && best < m && LZ_DIST_MAX >= lz->dlen - at + ip ){
+        best = m;
+        dist = lz->dlen - at + ip;
+      }
+    }
+
+    lz->ftab[h] = (uint32_t) ip;
+    lz->fepoch[h] = lz->epoch;
+
+    // Literal runs are walked faster the longer they get, as in LZ4
+    if( !best ){
+      ip += 1 + ( ( ip - anchor ) >> 6 );
+      continue;
+    }
+
+    op = lz_sequence( op, end, &src[ anchor ], ip - anchor, dist, best );
+    if( !op )
+      return 0;
+    ip += best;
+    anchor = ip;
+  }
+
+  op = lz_sequence( op, end, &src[ anchor ], n - anchor, 0, 0 );
+  return op ? (size_t) ( op - dst ) : 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+lz_decompress(
+  const lz_t * lz,
+  const uint8_t * src,
+  const size_t n,
+  uint8_t * dst,
+  const size_t cap,
+  size_t * len
+){
+  size_t ip = 0;
+  size_t op = 0;
+
+  while( ip < n ){
+    const uint8_t token = src[ ip ++ ];
+
+    size_t nlit = token >> 4;
+    for( uint8_t b = 255 ; 15 == token >> 4 && 255 == b ; nlit += b ){
+      if( ip >= n )
+        return -1;
+      b = src[ ip ++ ];
+    }
+
+    if( nlit > n - ip || nlit > cap - op )
+      return -1;
+    (void) memcpy( &dst[ op ], &src[ ip ], nlit );
+    ip += nlit;
+    op += nlit;
+    if( ip == n )
+      break;
+
+    if( 2 > n - ip )
+      return -1;
+    const size_t dist = (size_t) src[ ip ] | (size_t) src[ ip + 1 ] << 8;
+    ip += 2;
+
+    size_t mlen = token & 15;
+    for( uint8_t b = 255 ; 15 == ( token & 15 ) && 255 == b ; mlen += b ){
+      if( ip >= n )
+        return -1;
+      b = src[ ip ++ ];
+    }
+    mlen += MIXLINK_LZ_MIN_MATCH;
+
+    if( !dist || dist > op + lz->dlen || mlen > cap - op )
+      return -1;
+
+    // Byte by byte, a match may overlap what it writes or start in the dictionary
+    for( size_t k = 0 ; k < mlen ; ++k, ++op )
+      dst[ op ] = ( dist <= op ) ? dst[ op - dist ] : lz->dict[ lz->dlen + op - dist ];
+  }
+
+  *len = op;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_lz_init(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  if( def->priv )
+    return 0;
+
+  const long min = mixlink_abi_arg( def->args, "min", MIXLINK_LZ_MIN );
+  const long budget = mixlink_abi_arg( def->args, "budget", MIXLINK_LZ_BUDGET_US );
+  const long baud = mixlink_abi_arg( def->args, "baud", 0 );
+  if( 0 > min || 0 >= budget || 0 > baud ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  lz_t * lz = calloc( 1, sizeof(lz_t) );
+  if( !lz )
+    return -1;
+
+  // Without a dictionary the frame is its own only history
+  char path[ PATH_MAX ];
+  if( mixlink_abi_arg_str( def->args, "dict", path, sizeof(path) ) && -1 == lz_load( lz, path ) ){
+    free( lz );
+    return -1;
+  }
+
+  lz->id      = (uint8_t) ( MIXLINK_LZ_BLOCK | ( mixlink_crc32c( lz->dict, lz->dlen ) & 0x7F ) );
+  lz->min     = (size_t) min;
+  lz->budget  = (uint64_t) budget * 1000u;
+  lz->byte_ns = baud ? 1e9 * LZ_BYTE_BITS / (double) baud : 0;
+  lz->saved   = 0.5;
+  def->priv = lz;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_lz_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  free( def->priv );
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_lz_tx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  lz_t * lz = (lz_t *) abi->priv;
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+  const size_t n = in->len;
+  if( out->size < n + 1 ){
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  abi->n_out = 1;
+
+  // Below 1/64 the type byte and the time spent are not worth it
+  bool attempt = ( lz->min <= n && n );
+  if( attempt && ( 1.0 / 64 > lz->saved || ( lz->byte_ns && lz->cost > lz->saved * lz->byte_ns ) ) )
+    attempt = ( MIXLINK_LZ_PROBE <= ++ lz->skipped );
+
+  if( attempt ){
+    const uint64_t start = lz_now();
+    uint64_t budget = lz->budget;
+    if( lz->byte_ns && (double) budget > lz->byte_ns * (double) n )
+      budget = (uint64_t) ( lz->byte_ns * (double) n );
+
+    const size_t c = lz_compress( lz, in->val, n, &out->val[1], n - 1, start + budget );
+    const double spent = (double) ( lz_now() - start ) / (double) n;
+
+    lz->skipped = 0;
+    lz->cost  += ( spent - lz->cost ) / 4;
+    lz->saved += ( ( c ? (double) ( n - c ) / (double) n : 0 ) - lz->saved ) / 4;
+
+    if( c ){
+      out->val[0] = lz->id;
+      out->len = c + 1;
+      return 0;
+    }
+  }
+
+  out->val[0] = MIXLINK_LZ_RAW;
+  (void) memcpy( &out->val[1], in->val, n );
+  out->len = n + 1;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_lz_rx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  const lz_t * lz = (const lz_t *) abi->priv;
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+  if( !in->len ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  abi->n_out = 1;
+
+  if( MIXLINK_LZ_RAW == in->val[0] ){
+    if( out->size + 1 < in->len ){
+      errno = EMSGSIZE;
+      return -1;
+    }
+    (void) memcpy( out->val, &in->val[1], in->len - 1 );
+    out->len = in->len - 1;
+    return 0;
+  }
+
+  // Another dictionary would decode into valid looking garbage
+  if( lz->id != in->val[0] || -1 == lz_decompress( lz, &in->val[1], in->len - 1, out->val, out->size, &out->len ) ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  return 0;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -32,10 +32,13 @@
 #include <argp.h>
 #include <xcxml.h>
 #include <unistd.h>
+#include <signal.h>
+#include <sys/signalfd.h>
 
 #include "mixlink.h"
 #include "translator.h"
 #include "controller.h"
+#include "pipeline.h"
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * argp program interfaces 
@@ -116,9 +119,14 @@ static const xml_field_t xml_fields[ ] = {
   XML_FIELD( "/instance/controller/default/device", mixlink_args_t, controller.dev.def.device ),
   XML_FIELD( "/instance/controller/default/driver", mixlink_args_t, controller.dev.def.driver ),
 
+  XML_FIELD( "/instance/controller/sched"         , mixlink_args_t, controller.sched ),
   XML_FIELD( "/instance/controller/qos"           , mixlink_args_t, controller.qos ),
   XML_FIELD( "/instance/controller/framer"        , mixlink_args_t, controller.framer ),
   XML_FIELD( "/instance/controller/segm"          , mixlink_args_t, controller.segm ),
+  XML_FIELD( "/instance/controller/agg"           , mixlink_args_t, controller.agg ),
+  XML_FIELD( "/instance/controller/fec"           , mixlink_args_t, controller.fec ),
+  XML_FIELD( "/instance/controller/mac"           , mixlink_args_t, controller.mac ),
+  XML_FIELD( "/instance/controller/check"         , mixlink_args_t, controller.check ),
 
   XML_FIELD( "/instance/translator/tx/name"       , mixlink_args_t, translator.nic.pair.tx.name ),
   XML_FIELD( "/instance/translator/tx/device"     , mixlink_args_t, translator.nic.pair.tx.name ),
@@ -132,8 +140,14 @@ static const xml_field_t xml_fields[ ] = {
   XML_FIELD( "/instance/translator/default/device", mixlink_args_t, translator.nic.def.name ),
   XML_FIELD( "/instance/translator/default/driver", mixlink_args_t, translator.nic.def.name ),
 
+  XML_FIELD( "/instance/translator/mac"           , mixlink_args_t, translator.mac ),
   XML_FIELD( "/instance/translator/opt"           , mixlink_args_t, translator.opt ),
+  XML_FIELD( "/instance/translator/comp"          , mixlink_args_t, translator.comp ),
   XML_FIELD( "/instance/translator/framer"        , mixlink_args_t, translator.framer ),
+  XML_FIELD( "/instance/translator/backend"       , mixlink_args_t, translator.backend ),
+  XML_FIELD( "/instance/translator/mmap"          , mixlink_args_t, translator.mmap ),
+  XML_FIELD( "/instance/translator/filter/drop"   , mixlink_args_t, translator.filter.drop ),
+  XML_FIELD( "/instance/translator/filter/program", mixlink_args_t, translator.filter.program ),
 };
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -185,6 +199,10 @@ load_xml(
  * Stack Code 
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
+#define MIXLINK_STACK_MAX_STEPS 16
+#define MIXLINK_RETRY_MIN_MS    1                                              //!< First delay before retrying a step that is not ready
+#define MIXLINK_RETRY_MAX_MS    1000                                           //!< The retry delay doubles up to this value
+
 enum step_type {
   STEP_MOD_CORE,
   STEP_MOD_DRIVER
@@ -207,14 +225,33 @@ typedef struct {
     } mod_driver;
     
   } call;
+
+  mixlink_module_t * mod;                                                      //!< Module called by the step, NULL if there is none
+  mixlink_event_t * timer;                                                     //!< Loop steps only, armed by the module or by a retry
+  uint32_t backoff;                                                            //!< Delay in ms of the next retry
 } stack_step_t;
 
-#define MIXLINK_CORE_STEP( phase, name, obj )                  \
-  { "mixlink_" #name "_" #phase, STEP_MOD_CORE,                \
+//!< Everything the main thread reacts to: termination signals, the loop of each module and retries
+typedef struct {
+  mixlink_reactor_t reactor;
+  bool opened;
+  int sfd;                                                                     //!< signalfd of SIGINT and SIGTERM
+  bool stop;
+
+  mixlink_event_t * retry;
+  bool retry_fired;
+
+  stack_step_t loop[ MIXLINK_STACK_MAX_STEPS ];
+  size_t nloop;
+} stack_ctx_t;
+
+#define MIXLINK_CORE_STEP( phase, prefix, name, obj )          \
+  { "mixlink_" #prefix "_" #name "_" #phase, STEP_MOD_CORE,    \
     .call.mod_core = {                                         \
-      (int8_t (*)(void *)) mixlink_##name##_##phase,           \
+      (int8_t (*)(void *)) mixlink_##prefix##_##name##_##phase,\
       obj                                                      \
-    }                                                          \
+    },                                                         \
+    .mod = &(obj)->name                                        \
   }
 
 #define MIXLINK_DRIVER_STEP( phase, dir, obj )                 \
@@ -223,130 +260,311 @@ typedef struct {
       mixlink_controller_driver_##phase,                       \
       dir,                                                     \
       obj                                                      \
-    }                                                          \
+    },                                                         \
+    .mod = stack_driver_module( dir, obj )                     \
   }                                                       
 
+mixlink_module_t * stack_driver_module(
+  const enum direction dir,
+  mixlink_controller_t * controller
+);
+
+int8_t run_step(
+  stack_step_t * step
+);
+
+int8_t on_signal(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+int8_t on_retry(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+int8_t on_loop(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+mixlink_module_t *
+stack_driver_module(
+  const enum direction dir,
+  mixlink_controller_t * controller
+){
+  struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
+    dir,
+    controller
+  );
+  return handler ? &handler->driver : NULL;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+stack_steps(
+  stack_step_t * steps,
+  const char * phase,
+  mixlink_translator_t * translator,
+  mixlink_controller_t * controller
+){
+  size_t nsteps = 0;
+
+#define MIXLINK_STACK_PHASE( phase )                                                                  \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, controller, sched,  controller );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, translator, mac,    translator );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, translator, opt,    translator );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, translator, comp,   translator );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, translator, framer, translator );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, controller, segm,   controller );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, controller, framer, controller );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, controller, agg,    controller );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, controller, qos,    controller );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, controller, fec,    controller );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, controller, mac,    controller );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( phase, controller, check,  controller );     \
+  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_DRIVER_STEP( phase, MIXLINK_DIRECTION_FROM_NIC, controller ); \
+  if( !controller->def.enabled )                                                                     \
+    steps[ nsteps ++ ] = (stack_step_t) MIXLINK_DRIVER_STEP( phase, MIXLINK_DIRECTION_TO_NIC, controller );
+
+  if( !strcmp( phase, "init" ) ){
+    MIXLINK_STACK_PHASE( init )
+  }
+  else if( !strcmp( phase, "deinit" ) ){
+    MIXLINK_STACK_PHASE( deinit )
+  }
+  else if( !strcmp( phase, "loop" ) ){
+    MIXLINK_STACK_PHASE( loop )
+  }
+
+#undef MIXLINK_STACK_PHASE
+
+  return nsteps;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+run_step(
+  stack_step_t * step
+){
+  switch( step->type ){
+    case STEP_MOD_CORE:
+      return step->call.mod_core.fn(
+        step->call.mod_core.obj
+      );
+
+    case STEP_MOD_DRIVER:
+      return step->call.mod_driver.fn(
+        step->call.mod_driver.dir,
+        step->call.mod_driver.obj
+      );
+  }
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+on_signal(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  (void) events;
+
+  struct signalfd_siginfo info;
+  if( (ssize_t) sizeof(info) == read( ev->fd, &info, sizeof(info) ) )
+    ((stack_ctx_t *) ev->arg)->stop = true;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+on_retry(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  (void) events;
+  ((stack_ctx_t *) ev->arg)->retry_fired = true;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+on_loop(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  (void) events;
+  stack_step_t * step = (stack_step_t *) ev->arg;
+
+  const int8_t ret = run_step( step );
+
+  if( 0 == ret ){
+    step->backoff = MIXLINK_RETRY_MIN_MS;
+    return 0;
+  }
+
+  if( -1 == ret ){
+    error_print( "[loop] failed on step: %s", step->name );
+    return -1;
+  }
+
+  // Not ready, the module is polled again with an exponential backoff until it schedules itself
+  (void) mixlink_reactor_schedule( step->timer, step->backoff );
+  if( step->backoff < MIXLINK_RETRY_MAX_MS )
+    step->backoff *= 2;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
 int8_t
 run_stack_steps( 
   const char * phase, 
   stack_step_t * steps, 
-  size_t nsteps
+  size_t nsteps,
+  stack_ctx_t * ctx
 ){
   for( size_t i = 0 ; i < nsteps ; ++i ){
-    int8_t ret = 1;
-
-    while( 0 != ret ){
-      switch( steps[i].type ){
-        case STEP_MOD_CORE:
-          ret = steps[i].call.mod_core.fn(
-            steps[i].call.mod_core.obj
-          );
-          break;
-
-        case STEP_MOD_DRIVER:
-          ret = steps[i].call.mod_driver.fn(
-            steps[i].call.mod_driver.dir,
-            steps[i].call.mod_driver.obj
-          );
-          break;
-      }
+    uint32_t backoff = MIXLINK_RETRY_MIN_MS;
 
-      if( ret )
-        usleep( 1e6 );  // retry on temporary failure
+    for( ; ; ){
+      const int8_t ret = run_step( &steps[i] );
+      if( 0 == ret )
+        break;
 
       if( -1 == ret ){
         if (errno == EINVAL)
           error_print("[%s] failed on step: %s", phase, steps[i].name );
         return -1;
       }
+
+      // Retry on temporary failure, a termination signal gives up
+      ctx->retry_fired = false;
+      (void) mixlink_reactor_schedule( ctx->retry, backoff );
+      if( backoff < MIXLINK_RETRY_MAX_MS )
+        backoff *= 2;
+
+      while( !ctx->retry_fired && !ctx->stop )
+        if( -1 == mixlink_reactor_wait( &ctx->reactor, -1 ) )
+          return -1;
+
+      if( ctx->stop )
+        return -1;
     }
 
   }
   return 0;
 }
 
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+open_stack(
+  stack_ctx_t * ctx,
+  mixlink_translator_t * translator,
+  mixlink_controller_t * controller
+){
+  ctx->sfd = -1;
+  if( -1 == mixlink_reactor_init( &ctx->reactor ) )
+    return -1;
+  ctx->opened = true;
+
+  // The pipeline threads inherit the mask, so the termination signals are only seen here
+  sigset_t mask;
+  (void) sigemptyset( &mask );
+  (void) sigaddset( &mask, SIGINT );
+  (void) sigaddset( &mask, SIGTERM );
+  (void) pthread_sigmask( SIG_BLOCK, &mask, NULL );
+
+  ctx->sfd = signalfd( -1, &mask, SFD_NONBLOCK | SFD_CLOEXEC );
+  if( 0 > ctx->sfd || !mixlink_reactor_add_fd( &ctx->reactor, ctx->sfd, EPOLLIN, on_signal, ctx ) )
+    return -1;
+
+  ctx->retry = mixlink_reactor_add_timer( &ctx->reactor, on_retry, ctx );
+  if( !ctx->retry )
+    return -1;
+
+  // Each module gets its own timer to schedule its loop, this must be ready before init
+  ctx->nloop = stack_steps( ctx->loop, "loop", translator, controller );
+  for( size_t i = 0 ; i < ctx->nloop ; ++i ){
+    stack_step_t * step = &ctx->loop[i];
+    step->backoff = MIXLINK_RETRY_MIN_MS;
+    step->timer = mixlink_reactor_add_timer( &ctx->reactor, on_loop, step );
+    if( !step->timer )
+      return -1;
+
+    if( step->mod ){
+      step->mod->def.schedule = mixlink_reactor_schedule;
+      step->mod->def.ctx = step->timer;
+    }
+  }
+
+  return 0;
+}
+
+void
+close_stack(
+  stack_ctx_t * ctx
+){
+  if( !ctx->opened )
+    return;
+
+  mixlink_reactor_close( &ctx->reactor );
+  if( 0 <= ctx->sfd )
+    (void) close( ctx->sfd );
+  ctx->opened = false;
+}
 
 int8_t 
 init_stack( 
+  stack_ctx_t * ctx,
   mixlink_translator_t * translator,
   mixlink_controller_t * controller
 ){
-  const size_t maxsteps = 8;
-  stack_step_t steps[ maxsteps ];  
-  size_t nsteps = 0;
-
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( init, translator_opt,    translator );
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( init, translator_framer, translator );
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( init, controller_segm,   controller );
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( init, controller_framer, controller );
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( init, controller_qos,    controller );
-
-  if( !controller->def.enabled ){
-    steps[ nsteps ++ ] = (stack_step_t) MIXLINK_DRIVER_STEP( init, MIXLINK_DIRECTION_FROM_NIC, controller );
-    steps[ nsteps ++ ] = (stack_step_t) MIXLINK_DRIVER_STEP( init, MIXLINK_DIRECTION_TO_NIC, controller );
-  }
-  else
-    steps[ nsteps ++ ] = (stack_step_t) MIXLINK_DRIVER_STEP( init, MIXLINK_DIRECTION_FROM_NIC, controller );
+  stack_step_t steps[ MIXLINK_STACK_MAX_STEPS ];  
+  const size_t nsteps = stack_steps( steps, "init", translator, controller );
 
   return run_stack_steps( 
     "init" , 
     steps,
-    nsteps
+    nsteps,
+    ctx
   );
 }
 
 int8_t 
 deinit_stack( 
+  stack_ctx_t * ctx,
   mixlink_translator_t * translator,
   mixlink_controller_t * controller
 ){
-  const size_t maxsteps = 8;
-  stack_step_t steps[ maxsteps ];  
-  size_t nsteps = 0;
-
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( deinit, translator_opt,    translator );
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( deinit, translator_framer, translator );
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( deinit, controller_segm,   controller );
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( deinit, controller_framer, controller );
-  steps[ nsteps ++ ] = (stack_step_t) MIXLINK_CORE_STEP( deinit, controller_qos,    controller );
+  stack_step_t steps[ MIXLINK_STACK_MAX_STEPS ];  
+  const size_t nsteps = stack_steps( steps, "deinit", translator, controller );
 
-  if( !controller->def.enabled ){
-    steps[ nsteps ++ ] = (stack_step_t) MIXLINK_DRIVER_STEP( deinit, MIXLINK_DIRECTION_FROM_NIC, controller );
-    steps[ nsteps ++ ] = (stack_step_t) MIXLINK_DRIVER_STEP( deinit, MIXLINK_DIRECTION_TO_NIC, controller );
-  }
-  else
-    steps[ nsteps ++ ] = (stack_step_t) MIXLINK_DRIVER_STEP( deinit, MIXLINK_DIRECTION_FROM_NIC, controller );  
+  // The stop request that led here must not cancel the retries of the deinit
+  ctx->stop = false;
 
   return run_stack_steps( 
     "deinit" , 
     steps,
-    nsteps
+    nsteps,
+    ctx
   );
 }
 
 int8_t 
 loop_stack( 
-  mixlink_translator_t * translator,
-  mixlink_controller_t * controller
+  stack_ctx_t * ctx
 ){
-  stack_step_t steps[ ] = {
-    MIXLINK_CORE_STEP( loop, translator_opt,    translator ),
-    MIXLINK_CORE_STEP( loop, translator_framer, translator ),
-    MIXLINK_CORE_STEP( loop, controller_segm,   controller ),
-    MIXLINK_CORE_STEP( loop, controller_framer, controller ),
-    MIXLINK_CORE_STEP( loop, controller_qos,    controller ),
-    MIXLINK_DRIVER_STEP( loop, MIXLINK_DIRECTION_FROM_NIC, controller ),
-    MIXLINK_DRIVER_STEP( loop, MIXLINK_DIRECTION_TO_NIC, controller )
-  };
-  size_t nsteps = sizeof( steps ) / sizeof( steps[0] );
+  // Every loop runs once, afterwards only when its timer expires
+  for( size_t i = 0 ; i < ctx->nloop ; ++i )
+    (void) mixlink_reactor_schedule( ctx->loop[i].timer, 0 );
 
-  return run_stack_steps( 
-    "loop" , 
-    steps,
-    nsteps
-  );
-}
+  while( !ctx->stop )
+    if( -1 == mixlink_reactor_wait( &ctx->reactor, -1 ) )
+      return -1;
 
+  return 0;
+}
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * Entry point
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -360,6 +578,8 @@ main(
   mixlink_args_t        xml_args   = { 0 };
   mixlink_translator_t  translator = { 0 };  
   mixlink_controller_t  controller = { 0 };
+  mixlink_pipeline_t    pipeline   = { 0 };
+  stack_ctx_t           stack      = { 0 };
 
   const error_t arg_ret = args_parse( 
     argc, 
@@ -381,6 +601,46 @@ main(
     return EXIT_FAILURE;
   }
 
+#ifdef MIXLINK_FIXED_STACK
+  // The stack was chosen at build time, the modules named in the XML are ignored
+#ifdef MIXLINK_FIXED_TRANSLATOR_MAC
+  (void) snprintf( xml_args.translator.mac, NAME_MAX, "%s", MIXLINK_FIXED_TRANSLATOR_MAC );
+#endif
+#ifdef MIXLINK_FIXED_TRANSLATOR_OPT
+  (void) snprintf( xml_args.translator.opt, NAME_MAX, "%s", MIXLINK_FIXED_TRANSLATOR_OPT );
+#endif
+#ifdef MIXLINK_FIXED_TRANSLATOR_COMP
+  (void) snprintf( xml_args.translator.comp, NAME_MAX, "%s", MIXLINK_FIXED_TRANSLATOR_COMP );
+#endif
+#ifdef MIXLINK_FIXED_TRANSLATOR_FRAMER
+  (void) snprintf( xml_args.translator.framer, NAME_MAX, "%s", MIXLINK_FIXED_TRANSLATOR_FRAMER );
+#endif
+#ifdef MIXLINK_FIXED_CONTROLLER_SCHED
+  (void) snprintf( xml_args.controller.sched, NAME_MAX, "%s", MIXLINK_FIXED_CONTROLLER_SCHED );
+#endif
+#ifdef MIXLINK_FIXED_CONTROLLER_SEGM
+  (void) snprintf( xml_args.controller.segm, NAME_MAX, "%s", MIXLINK_FIXED_CONTROLLER_SEGM );
+#endif
+#ifdef MIXLINK_FIXED_CONTROLLER_QOS
+  (void) snprintf( xml_args.controller.qos, NAME_MAX, "%s", MIXLINK_FIXED_CONTROLLER_QOS );
+#endif
+#ifdef MIXLINK_FIXED_CONTROLLER_FRAMER
+  (void) snprintf( xml_args.controller.framer, NAME_MAX, "%s", MIXLINK_FIXED_CONTROLLER_FRAMER );
+#endif
+#ifdef MIXLINK_FIXED_CONTROLLER_AGG
+  (void) snprintf( xml_args.controller.agg, NAME_MAX, "%s", MIXLINK_FIXED_CONTROLLER_AGG );
+#endif
+#ifdef MIXLINK_FIXED_CONTROLLER_FEC
+  (void) snprintf( xml_args.controller.fec, NAME_MAX, "%s", MIXLINK_FIXED_CONTROLLER_FEC );
+#endif
+#ifdef MIXLINK_FIXED_CONTROLLER_MAC
+  (void) snprintf( xml_args.controller.mac, NAME_MAX, "%s", MIXLINK_FIXED_CONTROLLER_MAC );
+#endif
+#ifdef MIXLINK_FIXED_CONTROLLER_CHECK
+  (void) snprintf( xml_args.controller.check, NAME_MAX, "%s", MIXLINK_FIXED_CONTROLLER_CHECK );
+#endif
+#endif
+
 
   const int8_t trs_init_ret = mixlink_translator_init( 
     xml_args.translator, 
@@ -400,38 +660,61 @@ main(
     goto cleanup;
   }
 
-  const int8_t stack_init_ret = init_stack( 
+  const int8_t stack_open_ret = open_stack( 
+    &stack,
     &translator,
     &controller
   );
-  if( 0 != stack_init_ret ){
-    error_print("init_stack");
+  if( 0 != stack_open_ret ){
+    error_print("open_stack");
     goto cleanup;
   }
 
-  // Run the RX pipeline
-
-
-  // Run the TX pipeline
-
-  // Run the Loop pipeline
-  const int8_t stack_loop_ret = loop_stack( 
+  const int8_t stack_init_ret = init_stack( 
+    &stack,
     &translator,
     &controller
   );
-  if( 0 != stack_loop_ret ){
-    error_print("loop_stack");
+  if( 0 != stack_init_ret ){
+    error_print("init_stack");
     goto cleanup;
   }
 
-  sleep( 1 );
-
-  (void) deinit_stack( 
+  const int8_t pipe_init_ret = mixlink_pipeline_init( 
+    &pipeline,
     &translator,
     &controller
   );
+  if( 0 != pipe_init_ret ){
+    error_print("mixlink_pipeline_init");
+    goto deinit;
+  }
+
+  // Run the RX and TX pipelines
+  const int8_t pipe_start_ret = mixlink_pipeline_start( &pipeline );
+  if( 0 != pipe_start_ret ){
+    error_print("mixlink_pipeline_start");
+    goto stop;
+  }
+
+  // Run the Loop pipeline until a termination signal arrives
+  const int8_t stack_loop_ret = loop_stack( &stack );
+  if( 0 != stack_loop_ret )
+    error_print("loop_stack");
+
+  stop:
+    (void) mixlink_pipeline_stop( &pipeline );
+    mixlink_pipeline_close( &pipeline );
+
+  deinit:
+    (void) deinit_stack( 
+      &stack,
+      &translator,
+      &controller
+    );
 
   cleanup:
+    close_stack( &stack );
     mixlink_controller_close( &controller );
     mixlink_translator_close( &translator );
     return EXIT_SUCCESS;
@@ -30,17 +30,91 @@
 #include <dlfcn.h>
 #include <errno.h>
 #include <stddef.h>
+#include <pthread.h>
 
 #include "mixlink.h"
+#include "builtin.h"
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * Enumerations
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Global variables
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< A library opened by one or more modules, dlopen() hands the same handle and globals to all of them
+typedef struct{
+  void * handle;
+  pthread_mutex_t lock;
+  uint32_t refs;                                                               //!< Modules loaded from the library, the slot is free at 0
+} mod_lib_t;
+
+static pthread_mutex_t mod_libs_lock = PTHREAD_MUTEX_INITIALIZER;
+static mod_lib_t mod_libs[ MIXLINK_MODULE_MAX_LIBS ];
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+pthread_mutex_t * mod_lib_get(
+  void * handle
+);
+
+void mod_lib_put(
+  const pthread_mutex_t * lock
+);
+
+
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * Function Description
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+pthread_mutex_t *
+mod_lib_get(
+  void * handle
+){
+  mod_lib_t * free_lib = NULL;
+  pthread_mutex_t * lock = NULL;
+
+  (void) pthread_mutex_lock( &mod_libs_lock );
+  for( size_t i = 0 ; i < MIXLINK_MODULE_MAX_LIBS && !lock ; ++i ){
+    if( mod_libs[i].refs && handle == mod_libs[i].handle ){
+      mod_libs[i].refs ++;
+      lock = &mod_libs[i].lock;
+    }
+    else if( !mod_libs[i].refs && !free_lib )
+      free_lib = &mod_libs[i];
+  }
+
+  if( !lock && free_lib && 0 == pthread_mutex_init( &free_lib->lock, NULL ) ){
+    free_lib->handle = handle;
+    free_lib->refs = 1;
+    lock = &free_lib->lock;
+  }
+  (void) pthread_mutex_unlock( &mod_libs_lock );
+
+  return lock;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mod_lib_put(
+  const pthread_mutex_t * lock
+){
+  (void) pthread_mutex_lock( &mod_libs_lock );
+  for( size_t i = 0 ; i < MIXLINK_MODULE_MAX_LIBS ; ++i ){
+    if( !mod_libs[i].refs || lock != &mod_libs[i].lock )
+      continue;
+
+    if( 0 == -- mod_libs[i].refs )
+      (void) pthread_mutex_destroy( &mod_libs[i].lock );
+    break;
+  }
+  (void) pthread_mutex_unlock( &mod_libs_lock );
+}
+
 /**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
 int8_t 
 mixlink_mod_load( 
@@ -54,12 +128,64 @@ mixlink_mod_load(
     return -1;
   }
 
+  // The arguments of the module follow the first '?', the rest is the path itself
+  char file[NAME_MAX];
+  const char * query = strchr( path, '?' );
+  (void) snprintf( file, sizeof(file), "%.*s", query ? (int) ( query - path ) : (int) strlen( path ), path );
+  (void) snprintf( module->args, sizeof(module->args), "%s", query ? query + 1 : "" );
+  module->def.args = module->args;
+  path = file;
+
+  // Built-in modules are resolved from the table, the prefix of the section is not needed
+  if( 0 == strncmp( path, MIXLINK_BUILTIN_PREFIX, strlen( MIXLINK_BUILTIN_PREFIX ) ) ){
+    const mixlink_builtin_t * builtin = mixlink_builtin_find( &path[ strlen( MIXLINK_BUILTIN_PREFIX ) ] );
+    if( !builtin ){
+      warning_print( "no built-in module %s", path );
+      return -1;
+    }
+
+    module->handle  = NULL;
+    module->lock    = NULL;
+    module->version = builtin->version;
+
+    const struct {
+      int8_t (* fn)( void * );
+      mixlink_callback_t * cb;
+    }
+    builtins[ ] = {
+      {builtin->init,     &module->init    },
+      {builtin->loop,     &module->loop    },
+      {builtin->rx,       &module->rx      },
+      {builtin->tx,       &module->tx      },
+      {builtin->deinit,   &module->deinit  },
+      {builtin->rx_batch, &module->rx_batch},
+      {builtin->tx_batch, &module->tx_batch},
+    };
+
+    for( size_t i = 0 ; i < sizeof(builtins) / sizeof(builtins[0]) ; ++i ){
+      builtins[i].cb->fn      = builtins[i].fn;
+      builtins[i].cb->enabled = ( NULL != builtins[i].fn );
+    }
+
+    return 0;
+  }
+
   module->handle = dlopen( path, RTLD_NOW | RTLD_GLOBAL );
   if( !module->handle ){
     warning_print( "dlopen %s", dlerror( ) );
     return -1;
   }
 
+  // The library may share its state between the slots that load it, its calls are serialized across all of them
+  module->lock = mod_lib_get( module->handle );
+  if( !module->lock ){
+    warning_print( "more than %d module libraries", MIXLINK_MODULE_MAX_LIBS );
+    (void) dlclose( module->handle );
+    module->handle = NULL;
+    errno = ENOMEM;
+    return -1;
+  }
+
   const int8_t n_options = 5;
   struct {
     const char * suffix;
@@ -95,6 +221,35 @@ mixlink_mod_load(
     if( err )
       warning_print( "symbol %s not found in %s", symbol, path );
   }
+
+  // A module without the version symbol predates the batch functions
+  snprintf( symbol, sizeof(symbol), "%s_abi_version", iface_prefix );
+  const uint32_t * version = (const uint32_t *) dlsym( module->handle, symbol );
+  module->version = version ? *version : 1;
+
+  if( 2 > module->version )
+    return 0;
+
+  struct {
+    const char * suffix;
+    mixlink_callback_t * cb;
+  } 
+  batches[ ] = {
+    {"rx_batch", &module->rx_batch},
+    {"tx_batch", &module->tx_batch},
+  };
+
+  for( size_t i = 0 ; i < sizeof(batches) / sizeof(batches[0]) ; ++i ){
+    snprintf( symbol, sizeof(symbol), "%s_%s", iface_prefix, batches[i].suffix );
+
+    dlerror( );
+    batches[ i ].cb->fn = (int8_t (*)(void *)) dlsym( 
+      module->handle, 
+      symbol
+    );
+    batches[i].cb->enabled = ( NULL == dlerror( ) );
+  }
+
   return 0;
 }
 
@@ -116,6 +271,30 @@ mixlink_mod_exec(
   return 0;
 }
 
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t 
+mixlink_mod_call(
+  void * arg,
+  const mixlink_module_t * mod,
+  const mixlink_callback_t * cb
+){
+  if( !mod || !cb ){
+    errno = EINVAL; 
+    return -1;
+  }
+
+  // The caps are read before the lock, the module sets them once during init
+  pthread_mutex_t * lock = ( mod->lock && !( mod->def.caps & MIXLINK_CAP_THREADS ) ) ? mod->lock : NULL;
+  if( lock )
+    (void) pthread_mutex_lock( lock );
+
+  const int8_t ret = mixlink_mod_exec( arg, cb );
+
+  if( lock )
+    (void) pthread_mutex_unlock( lock );
+  return ret;
+}
+
 /**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
 int8_t 
 mixlink_mod_unload( 
@@ -127,13 +306,15 @@ mixlink_mod_unload(
     return -1;
   }
 
-  const int8_t n_options = 5;
+  const int8_t n_options = 7;
   mixlink_callback_t * symbols[ ] = {
     &module->init,
     &module->loop,
     &module->rx,   
     &module->tx,   
-    &module->deinit
+    &module->deinit,
+    &module->rx_batch,
+    &module->tx_batch
   };
 
   bool no_symbol_was_loaded = true;
@@ -141,9 +322,14 @@ mixlink_mod_unload(
     if( symbols[i]->enabled )
       no_symbol_was_loaded = false;
 
-  if( no_symbol_was_loaded )
+  if( no_symbol_was_loaded || !module->handle )
     return 0;
 
+  if( module->lock ){
+    mod_lib_put( module->lock );
+    module->lock = NULL;
+  }
+
   return (int8_t) dlclose( module->handle );
 }
 
@@ -160,10 +346,89 @@ mixlink_mod_exec_io(
   }      
 
   if( MIXLINK_DIRECTION_TO_NIC == dir )
-    return mixlink_mod_exec( abi, &(mod->rx) );
+    return mixlink_mod_call( abi, mod, &(mod->rx) );
   
   if( MIXLINK_DIRECTION_FROM_NIC == dir )
-    return mixlink_mod_exec( abi, &(mod->tx) );
+    return mixlink_mod_call( abi, mod, &(mod->tx) );
 
   return 0;  
 }
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+mixlink_mod_io_enabled(
+  const mixlink_module_t * mod,
+  const enum direction dir
+){
+  if( !mod )
+    return false;
+
+  if( MIXLINK_DIRECTION_TO_NIC == dir )
+    return mod->rx.enabled || mod->rx_batch.enabled;
+
+  if( MIXLINK_DIRECTION_FROM_NIC == dir )
+    return mod->tx.enabled || mod->tx_batch.enabled;
+
+  return false;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t 
+mixlink_mod_exec_batch(
+  mixlink_abi_gen_io_t * abi,
+  const enum direction dir, 
+  const mixlink_module_t * mod
+){
+  if( !mod || !abi ){
+    errno = EINVAL;
+    return -1;
+  }      
+
+  if( mixlink_mod_batch_enabled( mod, dir ) )
+    return mixlink_mod_call( 
+      (void *) abi, 
+      mod,
+      MIXLINK_DIRECTION_TO_NIC == dir ? &(mod->rx_batch) : &(mod->tx_batch) 
+    );
+
+  // Adapter for single buffer modules, each call gets the outputs left by the previous ones
+  mixlink_abi_gen_io_t one = *abi;
+  uint8_t used = 0;
+  uint8_t i = 0;
+
+  for( ; i < abi->n_in && used < abi->n_out ; ++i ){
+    const uint8_t room = (uint8_t) ( abi->n_out - used );
+
+    one.in[0] = abi->in[i];
+    one.n_in  = 1;
+    for( uint8_t k = 0 ; k < room ; ++k )
+      one.out[k] = abi->out[ used + k ];
+    one.n_out = room;
+
+    // Absorbed (1) and dropped (-1) inputs are consumed without outputs
+    if( 0 == mixlink_mod_exec_io( (void *) &one, dir, mod ) && one.n_out <= room )
+      used = (uint8_t) ( used + one.n_out );
+  }
+
+  abi->n_in  = i;
+  abi->n_out = used;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+mixlink_mod_batch_enabled(
+  const mixlink_module_t * mod,
+  const enum direction dir
+){
+  if( !mod )
+    return false;
+
+  if( MIXLINK_DIRECTION_TO_NIC == dir )
+    return mod->rx_batch.enabled;
+
+  if( MIXLINK_DIRECTION_FROM_NIC == dir )
+    return mod->tx_batch.enabled;
+
+  return false;
+}
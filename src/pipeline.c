@@ -0,0 +1,1104 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      pipeline.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Pipeline runtime, runs the stack of each direction on its own thread.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+
+#include "pipeline.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+int8_t stage_driver(
+  mixlink_abi_gen_io_t * abi,
+  const enum direction dir,
+  void * obj
+);
+
+int8_t path_build(
+  struct mixlink_path * path,
+  const enum direction dir,
+  mixlink_pipeline_t * pipeline
+);
+
+int8_t path_on_source(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+int8_t path_on_timer(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+int8_t path_on_pace(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+int8_t path_on_policy(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+int8_t path_on_revive(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+void path_detach(
+  struct mixlink_path * path
+);
+
+void path_resync(
+  struct mixlink_path * path
+);
+
+size_t path_source(
+  struct mixlink_path * path
+);
+
+void path_retire(
+  struct mixlink_path * path,
+  const uint8_t idx
+);
+
+void path_consume(
+  struct mixlink_path * path,
+  const uint8_t idx,
+  const size_t n
+);
+
+void path_link(
+  struct mixlink_path * path,
+  const uint8_t idx,
+  const mixlink_buf8_t * in,
+  const size_t k
+);
+
+uint32_t path_backlog(
+  struct mixlink_path * path,
+  const uint8_t idx
+);
+
+bool path_call(
+  struct mixlink_path * path,
+  const uint8_t idx,
+  mixlink_buf8_t * in
+);
+
+size_t path_batch(
+  struct mixlink_path * path,
+  const uint8_t idx
+);
+
+size_t path_stage(
+  struct mixlink_path * path,
+  const uint8_t idx
+);
+
+size_t path_source_mmap(
+  struct mixlink_path * path
+);
+
+size_t path_sink_mmap(
+  struct mixlink_path * path
+);
+
+size_t path_source_batch(
+  struct mixlink_path * path
+);
+
+size_t path_sink_batch(
+  struct mixlink_path * path
+);
+
+size_t path_sink(
+  struct mixlink_path * path
+);
+
+void * path_run(
+  void * arg
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Stage wrappers
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define X(name)                                              \
+  static int8_t                                              \
+  stage_translator_##name(                                   \
+    mixlink_abi_gen_io_t * abi,                              \
+    const enum direction dir,                                \
+    void * obj                                               \
+  ){                                                         \
+    return mixlink_translator_##name##_io(                   \
+      abi,                                                   \
+      dir,                                                   \
+      (const mixlink_translator_t *) obj                     \
+    );                                                       \
+  }                                                          \
+  static int8_t                                              \
+  stage_translator_##name##_batch(                           \
+    mixlink_abi_gen_io_t * abi,                              \
+    const enum direction dir,                                \
+    void * obj                                               \
+  ){                                                         \
+    return mixlink_translator_##name##_batch(                \
+      abi,                                                   \
+      dir,                                                   \
+      (const mixlink_translator_t *) obj                     \
+    );                                                       \
+  }
+MIXLINK_TRANSLATOR_MODULES
+#undef X
+
+#define X(name)                                              \
+  static int8_t                                              \
+  stage_controller_##name(                                   \
+    mixlink_abi_gen_io_t * abi,                              \
+    const enum direction dir,                                \
+    void * obj                                               \
+  ){                                                         \
+    return mixlink_controller_##name##_io(                   \
+      abi,                                                   \
+      dir,                                                   \
+      (const mixlink_controller_t *) obj                     \
+    );                                                       \
+  }                                                          \
+  static int8_t                                              \
+  stage_controller_##name##_batch(                           \
+    mixlink_abi_gen_io_t * abi,                              \
+    const enum direction dir,                                \
+    void * obj                                               \
+  ){                                                         \
+    return mixlink_controller_##name##_batch(                \
+      abi,                                                   \
+      dir,                                                   \
+      (const mixlink_controller_t *) obj                     \
+    );                                                       \
+  }
+MIXLINK_CONTROLLER_MODULES
+#undef X
+
+#ifdef MIXLINK_FIXED_BUILTINS
+// The fixed stack lists its slots as X( layer, slot, builtin ), each one calls its built-in module directly
+#define X( layer, name, builtin )                            \
+  static int8_t                                              \
+  stage_fixed_##layer##_##name(                              \
+    mixlink_abi_gen_io_t * abi,                              \
+    const enum direction dir,                                \
+    void * obj                                               \
+  ){                                                         \
+    (void) obj;                                              \
+    return mixlink_builtin_##builtin##_io( abi, dir );       \
+  }
+MIXLINK_FIXED_BUILTINS
+#undef X
+#endif
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+stage_driver(
+  mixlink_abi_gen_io_t * abi,
+  const enum direction dir,
+  void * obj
+){
+  return mixlink_controller_driver_io(
+    abi,
+    dir,
+    (mixlink_controller_t *) obj
+  );
+}
+
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+path_on_source(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  struct mixlink_path * path = (struct mixlink_path *) ev->arg;
+
+  // A serial port that is gone keeps reporting its hang-up, it is left alone until the timer reopens it
+  if( path->revive && ( ( EPOLLHUP | EPOLLERR ) & events ) ){
+    path_detach( path );
+    return 0;
+  }
+
+  path->readable = true;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+path_on_timer(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  (void) events;
+  ((mixlink_stage_t *) ev->arg)->kick = true;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+path_on_pace(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  // Only wakes the thread, the sink asks the pacer again
+  (void) ev;
+  (void) events;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+path_on_policy(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  mixlink_controller_t * controller = ((struct mixlink_path *) ev->arg)->pipeline->controller;
+
+  (void) events;
+  mixlink_link_policy_run( &controller->policy, &controller->link );
+  return mixlink_reactor_schedule( ev, MIXLINK_LINK_PERIOD_MS );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+path_on_revive(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  struct mixlink_path * path = (struct mixlink_path *) ev->arg;
+
+  // One attempt per expiry, the thread keeps serving its timers in between
+  (void) events;
+  if( !path->lost )
+    return 0;
+
+  if( -1 == mixlink_controller_reopen( path->dir, path->pipeline->controller, path->gen, 1 ) ){
+    const uint32_t ms = path->revive_ms;
+    path->revive_ms = ( MIXLINK_PIPELINE_REOPEN_MAX_MS / 2 < ms ) ? MIXLINK_PIPELINE_REOPEN_MAX_MS : 2 * ms;
+    return mixlink_reactor_schedule( ev, ms );
+  }
+
+  path_resync( path );
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+path_detach(
+  struct mixlink_path * path
+){
+  if( path->lost )
+    return;
+
+  warning_print( "serial port lost, reopening" );
+  (void) mixlink_reactor_rebind( path->source, -1, 0 );
+  path->lost = true;
+  path->readable = false;
+  path->revive_ms = MIXLINK_PIPELINE_REOPEN_MS;
+  (void) mixlink_reactor_schedule( path->revive, MIXLINK_PIPELINE_REOPEN_MS );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+path_resync(
+  struct mixlink_path * path
+){
+  mixlink_controller_t * controller = path->pipeline->controller;
+  const uint32_t gen = mixlink_controller_gen( path->dir, controller );
+  if( gen == path->gen && !path->lost )
+    return;
+
+  // The reopen closed the descriptor epoll watched, even if the new one got the same number
+  path->gen = gen;
+  if( -1 == mixlink_reactor_rebind( path->source, mixlink_controller_fd( path->dir, controller ), EPOLLIN ) ){
+    path->lost = false;
+    path_detach( path );
+    return;
+  }
+
+  path->lost = false;
+  path->paused = false;
+  path->readable = true;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+path_build(
+  struct mixlink_path * path,
+  const enum direction dir,
+  mixlink_pipeline_t * pipeline
+){
+  mixlink_translator_t * translator = pipeline->translator;
+  mixlink_controller_t * controller = pipeline->controller;
+
+  struct serial_handler * handler = mixlink_controller_driver_pipeline_handler(
+    dir,
+    controller
+  );
+
+  // Stages in the TX order, the RX direction walks them backwards. Unlike `loop_stack()`, the QoS runs before the controller
+  // framer: its sequence numbers and acknowledgements must sit inside the delimited frame, so the RX deframer hands it whole
+  // frames and a corrupted delimiter costs one frame instead of desynchronizing the QoS
+  const mixlink_stage_t order[ ] = {
+    { "controller_sched",  stage_controller_sched,  stage_controller_sched_batch,  controller, &controller->sched,  NULL, false, NULL },
+    { "translator_mac",    stage_translator_mac,    stage_translator_mac_batch,    translator, &translator->mac,    NULL, false, NULL },
+    { "translator_opt",    stage_translator_opt,    stage_translator_opt_batch,    translator, &translator->opt,    NULL, false, NULL },
+    { "translator_comp",   stage_translator_comp,   stage_translator_comp_batch,   translator, &translator->comp,   NULL, false, NULL },
+    { "translator_framer", stage_translator_framer, stage_translator_framer_batch, translator, &translator->framer, NULL, false, NULL },
+    { "controller_segm",   stage_controller_segm,   stage_controller_segm_batch,   controller, &controller->segm,   NULL, false, NULL },
+    { "controller_agg",    stage_controller_agg,    stage_controller_agg_batch,    controller, &controller->agg,    NULL, false, NULL },
+    { "controller_qos",    stage_controller_qos,    stage_controller_qos_batch,    controller, &controller->qos,    NULL, false, NULL },
+    { "controller_fec",    stage_controller_fec,    stage_controller_fec_batch,    controller, &controller->fec,    NULL, false, NULL },
+    { "controller_mac",    stage_controller_mac,    stage_controller_mac_batch,    controller, &controller->mac,    NULL, false, NULL },
+    { "controller_check",  stage_controller_check,  stage_controller_check_batch,  controller, &controller->check,  NULL, false, NULL },
+    { "controller_framer", stage_controller_framer, stage_controller_framer_batch, controller, &controller->framer, NULL, false, NULL },
+    { "controller_driver", stage_driver,            NULL,                          controller, handler ? &handler->driver : NULL, NULL, false, NULL },
+  };
+  const uint8_t n = (uint8_t) ( sizeof(order) / sizeof(order[0]) );
+
+  (void) memset( path, 0, sizeof(struct mixlink_path) );
+  path->dir = dir;
+  path->pipeline = pipeline;
+
+  if( -1 == mixlink_reactor_init( &path->reactor ) )
+    return -1;
+
+  const int fd = ( MIXLINK_DIRECTION_FROM_NIC == dir ) ?
+    mixlink_translator_fd( dir, translator ) :
+    mixlink_controller_fd( dir, controller );
+
+  path->mmap = mixlink_translator_ring( dir, translator );
+
+  if( 0 <= fd ){
+    path->source = mixlink_reactor_add_fd( &path->reactor, fd, EPOLLIN, path_on_source, path );
+    if( !path->source )
+      goto failed;
+  }
+
+  // The serial port may be unplugged and replugged, its new descriptor replaces the old one in the reactor
+  if( 0 <= fd && MIXLINK_DIRECTION_TO_NIC == dir ){
+    path->gen = mixlink_controller_gen( dir, controller );
+    path->revive = mixlink_reactor_add_timer( &path->reactor, path_on_revive, path );
+    if( !path->revive )
+      goto failed;
+  }
+
+  // Both directions feed the policy, only one runs it
+  if( MIXLINK_DIRECTION_FROM_NIC == dir ){
+    path->policy = mixlink_reactor_add_timer( &path->reactor, path_on_policy, path );
+    if( !path->policy || -1 == mixlink_reactor_schedule( path->policy, MIXLINK_LINK_PERIOD_MS ) )
+      goto failed;
+
+    path->pace = mixlink_reactor_add_timer( &path->reactor, path_on_pace, path );
+    if( !path->pace )
+      goto failed;
+
+    if( -1 == mixlink_air_init( &controller->air, handler ? &handler->radio : NULL, handler ? handler->driver.def.args : NULL ) ){
+      error_print( "mixlink_air_init" );
+      goto failed;
+    }
+  }
+
+  for( uint8_t i = 0 ; i < n ; ++i ){
+    path->stage[i] = order[ MIXLINK_DIRECTION_FROM_NIC == dir ? i : n - 1 - i ];
+
+    // Single buffer modules keep the per-buffer loop, which pins slices to the exact input
+    if( !mixlink_mod_batch_enabled( path->stage[i].mod, dir ) )
+      path->stage[i].batch = NULL;
+
+#ifdef MIXLINK_FIXED_BUILTINS
+    // Slots bound at build time skip the callbacks of the module, the call is resolved by the compiler
+#define X( layer, name, builtin )                              \
+    if( path->stage[i].mod == &layer->name ){                  \
+      path->stage[i].fn = stage_fixed_##layer##_##name;        \
+      path->stage[i].batch = NULL;                             \
+    }
+    MIXLINK_FIXED_BUILTINS
+#undef X
+#endif
+    path->stage[i].timer = mixlink_reactor_add_timer( &path->reactor, path_on_timer, &path->stage[i] );
+    if( !path->stage[i].timer )
+      goto failed;
+  }
+
+  for( ; path->nstages <= n ; path->nstages ++ )
+    if( -1 == mixlink_ring_init( &path->ring[ path->nstages ], MIXLINK_PIPELINE_RING_SLOTS, MIXLINK_PIPELINE_BUFSIZE ) )
+      goto failed;
+
+  path->nstages = n;
+  return 0;
+
+  failed:
+    for( uint8_t i = 0 ; i < path->nstages ; ++i )
+      mixlink_ring_free( &path->ring[i] );
+    mixlink_reactor_close( &path->reactor );
+    path->nstages = 0;
+    return -1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+path_source(
+  struct mixlink_path * path
+){
+  mixlink_pipeline_t * pipeline = path->pipeline;
+
+  if( path->mmap && MIXLINK_DIRECTION_FROM_NIC == path->dir )
+    return path_source_mmap( path );
+
+  if( !path->readable )
+    return 0;
+
+  if( MIXLINK_DIRECTION_FROM_NIC == path->dir )
+    return path_source_batch( path );
+
+  mixlink_buf8_t * buf = mixlink_ring_reserve( &path->ring[0], 0 );
+  if( !buf ){
+    // Level triggered, so stop watching until the first stage makes room
+    (void) mixlink_reactor_watch( path->source, 0 );
+    path->paused = true;
+    return 0;
+  }
+
+  path->readable = false;
+  buf->len = mixlink_controller_read( buf, 0, buf->size, pipeline->controller );
+
+  if( !buf->len ){
+    if( ENODEV == errno || EIO == errno )
+      path_detach( path );
+    return 0;
+  }
+
+  mixlink_ring_commit( &path->ring[0], 1 );
+  return 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+path_retire(
+  struct mixlink_path * path,
+  const uint8_t idx
+){
+  mixlink_ring_t * ring = &path->ring[ idx ];
+
+  // Release in order, stopping at the first slot still referenced by a slice downstream
+  while( path->done[ idx ] ){
+    const size_t slot = ring->tail & ring->mask;
+    if( path->ref[ idx ][ slot ] )
+      break;
+
+    mixlink_ring_release( ring, 1 );
+    path->done[ idx ] --;
+
+    if( idx && path->src[ idx ][ slot ] ){
+      const size_t up = path->src[ idx ][ slot ] - 1u;
+      path->src[ idx ][ slot ] = 0;
+      path->ref[ idx - 1 ][ up ] --;
+      path_retire( path, (uint8_t) ( idx - 1 ) );
+    }
+  }
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+path_consume(
+  struct mixlink_path * path,
+  const uint8_t idx,
+  const size_t n
+){
+  path->done[ idx ] += n;
+  path_retire( path, idx );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+path_link(
+  struct mixlink_path * path,
+  const uint8_t idx,
+  const mixlink_buf8_t * in,
+  const size_t k
+){
+  mixlink_ring_t * rin  = &path->ring[ idx ];
+  mixlink_ring_t * rout = &path->ring[ idx + 1 ];
+
+  // The input stays in its ring until the output with slices is released
+  const size_t slot = (size_t) ( in - rin->slot );
+  path->src[ idx + 1 ][ ( rout->head + k ) & rout->mask ] = (uint8_t) ( slot + 1 );
+  path->ref[ idx ][ slot ] ++;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint32_t
+path_backlog(
+  struct mixlink_path * path,
+  const uint8_t idx
+){
+  // The thread owns every ring of its direction, so the counts are exact
+  uint32_t n = 0;
+  for( uint8_t r = (uint8_t) ( idx + 1 ) ; r <= path->nstages ; ++r ){
+    n += (uint32_t) ( mixlink_ring_count( &path->ring[r] ) - path->done[r] );
+    if( r < path->nstages )
+      n += path->held[r];
+  }
+  return n;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+path_call(
+  struct mixlink_path * path,
+  const uint8_t idx,
+  mixlink_buf8_t * in
+){
+  mixlink_stage_t * stage = &path->stage[ idx ];
+  mixlink_ring_t * rout = &path->ring[ idx + 1 ];
+
+  size_t space = mixlink_ring_space( rout );
+  if( !space )
+    return false;
+
+  if( space > MIXLINK_MODULE_MAX_PORTS )
+    space = MIXLINK_MODULE_MAX_PORTS;
+
+  mixlink_abi_gen_io_t abi;
+  (void) memset( &abi, 0, sizeof(abi) );
+  if( in ){
+    abi.in[0] = in;
+    abi.n_in  = 1;
+  }
+  for( size_t k = 0 ; k < space ; ++k )
+    abi.out[k] = mixlink_ring_reserve( rout, k );
+  abi.n_out = (uint8_t) space;
+  abi.wake = mixlink_reactor_schedule;
+  abi.wake_ctx = stage->timer;
+  abi.wake_reverse = stage->reverse ? mixlink_reactor_schedule : NULL;
+  abi.wake_reverse_ctx = stage->reverse;
+  abi.priv = stage->mod ? stage->mod->def.priv : NULL;
+  abi.link = &path->pipeline->controller->link;
+  abi.backlog = path_backlog( path, idx );
+  abi.held = path->held[ idx ];
+  abi.full = path->full[ idx ];
+
+  // A kick of a batch module is a batch with no input
+  const int8_t ret = ( stage->batch ? stage->batch : stage->fn )( &abi, path->dir, stage->obj );
+  path->drain[ idx ] |= abi.drain;
+  path->held[ idx ] = abi.held;
+  path->full[ idx ] = abi.full;
+
+  // 0 publishes the outputs, 1 means the input was absorbed without output (e.g., partial frame)
+  if( 0 == ret && abi.n_out <= space ){
+    for( size_t k = 0 ; in && k < abi.n_out ; ++k )
+      if( abi.out[k]->n_frag )
+        path_link( path, idx, in, k );
+    mixlink_ring_commit( rout, abi.n_out );
+  }
+  else if( -1 == ret )
+    warning_print( "stage %s dropped a buffer", stage->name );
+  else if( 0 == ret )
+    warning_print( "stage %s filled %u outputs of %zu, dropped", stage->name, abi.n_out, space );
+
+  return true;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+path_batch(
+  struct mixlink_path * path,
+  const uint8_t idx
+){
+  mixlink_stage_t * stage = &path->stage[ idx ];
+  mixlink_ring_t * rin  = &path->ring[ idx ];
+  mixlink_ring_t * rout = &path->ring[ idx + 1 ];
+  const bool frags = stage->mod->def.caps & MIXLINK_CAP_FRAGS;
+
+  mixlink_abi_gen_io_t abi;
+  (void) memset( &abi, 0, sizeof(abi) );
+
+  while( abi.n_in < MIXLINK_MODULE_MAX_PORTS ){
+    mixlink_buf8_t * in = mixlink_ring_peek( rin, path->done[ idx ] + abi.n_in );
+    if( !in )
+      break;
+
+    if( in->n_frag && !frags && -1 == mixlink_buf8_flatten( in ) ){
+      // Only a chain at the front can be dropped without reordering the batch
+      if( abi.n_in )
+        break;
+      warning_print( "stage %s dropped a %zu byte chain", stage->name, mixlink_buf8_total( in ) );
+      path_consume( path, idx, 1 );
+      continue;
+    }
+
+    abi.in[ abi.n_in ++ ] = in;
+  }
+
+  size_t space = mixlink_ring_space( rout );
+  if( space > MIXLINK_MODULE_MAX_PORTS )
+    space = MIXLINK_MODULE_MAX_PORTS;
+
+  if( !abi.n_in || !space )
+    return 0;
+
+  const uint8_t n = abi.n_in;
+  for( size_t k = 0 ; k < space ; ++k )
+    abi.out[k] = mixlink_ring_reserve( rout, k );
+  abi.n_out = (uint8_t) space;
+  abi.wake = mixlink_reactor_schedule;
+  abi.wake_ctx = stage->timer;
+  abi.wake_reverse = stage->reverse ? mixlink_reactor_schedule : NULL;
+  abi.wake_reverse_ctx = stage->reverse;
+  abi.priv = stage->mod->def.priv;
+  abi.link = &path->pipeline->controller->link;
+  abi.backlog = path_backlog( path, idx );
+  abi.held = path->held[ idx ];
+  abi.full = path->full[ idx ];
+
+  const int8_t ret = stage->batch( &abi, path->dir, stage->obj );
+  path->drain[ idx ] |= abi.drain;
+  path->held[ idx ] = abi.held;
+  path->full[ idx ] = abi.full;
+
+  // Absorbed (1) consumes the inputs the module reports like a success without outputs, only -1 drops the batch
+  if( 1 == ret )
+    abi.n_out = 0;
+
+  size_t consumed = ( abi.n_in <= n ) ? abi.n_in : n;
+  if( 0 <= ret && abi.n_out <= space ){
+    // Outputs are not mapped to inputs, slots retire in order so pinning the first one keeps the whole batch
+    for( size_t k = 0 ; consumed && k < abi.n_out ; ++k )
+      if( abi.out[k]->n_frag )
+        path_link( path, idx, abi.in[0], k );
+    mixlink_ring_commit( rout, abi.n_out );
+  }
+  else{
+    warning_print( "stage %s dropped %u buffers", stage->name, n );
+    consumed = n;
+  }
+
+  path_consume( path, idx, consumed );
+  return consumed;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+path_stage(
+  struct mixlink_path * path,
+  const uint8_t idx
+){
+  mixlink_stage_t * stage = &path->stage[ idx ];
+  mixlink_ring_t * rin  = &path->ring[ idx ];
+  mixlink_ring_t * rout = &path->ring[ idx + 1 ];
+  const bool bypass = !mixlink_mod_io_enabled( stage->mod, path->dir );
+  const bool frags = !bypass && ( stage->mod->def.caps & MIXLINK_CAP_FRAGS );
+
+  size_t done = 0;
+
+  if( stage->kick && !bypass && path_call( path, idx, NULL ) ){
+    stage->kick = false;
+    done ++;
+  }
+
+  // A stage that keeps as many buffers as it can leaves the rest in its ring, so the stages before it stall instead of dropping
+  if( !bypass && path->full[ idx ] )
+    return done;
+
+  if( !bypass && stage->batch )
+    return done + path_batch( path, idx );
+
+  for( ; done < MIXLINK_PIPELINE_BURST && ( bypass || !path->full[ idx ] ) ; ++done ){
+    mixlink_buf8_t * in = mixlink_ring_peek( rin, path->done[ idx ] );
+    if( !in )
+      break;
+
+    if( bypass ){
+      mixlink_buf8_t * out = mixlink_ring_reserve( rout, 0 );
+      if( !out )
+        break;
+      (void) memcpy( out->val, in->val, in->len );
+      out->len = in->len;
+      out->n_frag = in->n_frag;
+      (void) memcpy( out->frag, in->frag, in->n_frag * sizeof(mixlink_frag8_t) );
+      if( out->n_frag )
+        path_link( path, idx, in, 0 );
+      mixlink_ring_commit( rout, 1 );
+    }
+    else if( in->n_frag && !frags && -1 == mixlink_buf8_flatten( in ) )
+      warning_print( "stage %s dropped a %zu byte chain", stage->name, mixlink_buf8_total( in ) );
+    else if( !path_call( path, idx, in ) )
+      break;
+
+    path_consume( path, idx, 1 );
+  }
+
+  return done;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+path_source_mmap(
+  struct mixlink_path * path
+){
+  mixlink_translator_t * translator = path->pipeline->translator;
+
+  // The ring is checked in memory, the readiness of the socket only matters to wake the thread
+  path->readable = false;
+
+  size_t done = 0;
+  for( ; done < MIXLINK_PIPELINE_BURST ; ++done ){
+    mixlink_buf8_t * buf = mixlink_ring_reserve( &path->ring[0], done );
+    if( !buf ){
+      (void) mixlink_reactor_watch( path->source, 0 );
+      path->paused = true;
+      break;
+    }
+
+    mixlink_buf8_t frame;
+    if( 1 != mixlink_translator_rx_frame( &frame, translator ) )
+      break;
+
+    if( frame.len <= buf->size ){
+      (void) memcpy( buf->val, frame.val, frame.len );
+      buf->len = frame.len;
+    }
+    else
+      buf->len = 0;
+
+    mixlink_translator_rx_release( translator );
+    if( !buf->len ){
+      warning_print( "tx source dropped a %zu byte frame", frame.len );
+      break;
+    }
+  }
+
+  mixlink_ring_commit( &path->ring[0], done );
+  return done;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+path_source_batch(
+  struct mixlink_path * path
+){
+  mixlink_buf8_t * bufs[ MIXLINK_PIPELINE_BURST ];
+
+  size_t space = mixlink_ring_space( &path->ring[0] );
+  if( !space ){
+    // Level triggered, so stop watching until the first stage makes room
+    (void) mixlink_reactor_watch( path->source, 0 );
+    path->paused = true;
+    return 0;
+  }
+
+  if( space > MIXLINK_PIPELINE_BURST )
+    space = MIXLINK_PIPELINE_BURST;
+
+  for( size_t k = 0 ; k < space ; ++k )
+    bufs[k] = mixlink_ring_reserve( &path->ring[0], k );
+
+  // A full batch may leave frames behind, so the source stays readable until a read comes short
+  const size_t n = mixlink_translator_read_batch( bufs, space, path->pipeline->translator );
+  path->readable = ( n == space );
+
+  mixlink_ring_commit( &path->ring[0], n );
+  return n;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+path_sink_batch(
+  struct mixlink_path * path
+){
+  mixlink_ring_t * ring = &path->ring[ path->nstages ];
+  mixlink_buf8_t * bufs[ MIXLINK_PIPELINE_BURST ];
+
+  size_t n = 0;
+  for( ; n < MIXLINK_PIPELINE_BURST ; ++n ){
+    bufs[n] = mixlink_ring_peek( ring, n );
+    if( !bufs[n] )
+      break;
+  }
+
+  if( !n )
+    return 0;
+
+  // Same policy as a single write, frames the NIC refused are dropped instead of stalling the direction
+  const size_t sent = mixlink_translator_write_batch( path->pipeline->translator, bufs, n );
+  if( sent != n )
+    warning_print( "rx sink dropped %zu buffers", n - sent );
+
+  path_consume( path, path->nstages, n );
+  return n;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+path_sink_mmap(
+  struct mixlink_path * path
+){
+  mixlink_translator_t * translator = path->pipeline->translator;
+  mixlink_ring_t * ring = &path->ring[ path->nstages ];
+
+  size_t done = 0;
+  for( ; done < MIXLINK_PIPELINE_BURST ; ++done ){
+    mixlink_buf8_t * buf = mixlink_ring_front( ring );
+    if( !buf )
+      break;
+
+    // A full TX ring falls back to the plain socket instead of stalling the direction
+    mixlink_buf8_t frame;
+    // Copying into the TX ring is where the slices get flattened
+    const size_t total = mixlink_buf8_total( buf );
+    if( 1 == mixlink_translator_tx_frame( &frame, translator ) && total <= frame.size ){
+      (void) memcpy( frame.val, buf->val, buf->len );
+      frame.len = buf->len;
+      for( uint8_t i = 0 ; i < buf->n_frag ; ++i ){
+        (void) memcpy( &frame.val[ frame.len ], buf->frag[i].val, buf->frag[i].len );
+        frame.len += buf->frag[i].len;
+      }
+      mixlink_translator_tx_commit( frame.len, translator );
+    }
+    else if( mixlink_translator_write( translator, buf ) != total )
+      warning_print( "rx sink dropped a buffer" );
+
+    path_consume( path, path->nstages, 1 );
+  }
+
+  if( done && -1 == mixlink_translator_tx_flush( translator ) )
+    warning_print( "rx sink flush" );
+
+  return done;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+path_sink(
+  struct mixlink_path * path
+){
+  mixlink_pipeline_t * pipeline = path->pipeline;
+  mixlink_ring_t * ring = &path->ring[ path->nstages ];
+
+  if( path->mmap && MIXLINK_DIRECTION_TO_NIC == path->dir )
+    return path_sink_mmap( path );
+
+  if( MIXLINK_DIRECTION_TO_NIC == path->dir )
+    return path_sink_batch( path );
+
+  size_t done = 0;
+  for( ; done < MIXLINK_PIPELINE_BURST ; ++done ){
+    mixlink_buf8_t * buf = mixlink_ring_front( ring );
+    if( !buf )
+      break;
+
+    // The transceiver may hold the writes with its own flow control, e.g., AUX or CTS, it is polled until it takes more
+    if( !mixlink_controller_ready( pipeline->controller ) ){
+      (void) mixlink_reactor_schedule( path->pace, MIXLINK_AIR_POLL_MS );
+      break;
+    }
+
+    // A write the airtime budget or the shaper cannot cover yet stays in the ring, the stages before it hold the rest
+    const size_t total = mixlink_buf8_total( buf );
+    const uint32_t wait = mixlink_air_wait( &pipeline->controller->air, total );
+    if( wait ){
+      (void) mixlink_reactor_schedule( path->pace, wait );
+      break;
+    }
+
+    // The device layer already tried to recover, holding the buffer would stall the whole direction. A duplex port it
+    // reopened must also be watched again by the RX thread
+    if( mixlink_controller_write( pipeline->controller, buf ) != total ){
+      warning_print( "tx sink dropped a buffer" );
+      (void) mixlink_reactor_wake( &pipeline->rx.reactor );
+    }
+    mixlink_air_sent( &pipeline->controller->air, total );
+
+    path_consume( path, path->nstages, 1 );
+  }
+
+  return done;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void *
+path_run(
+  void * arg
+){
+  struct mixlink_path * path = (struct mixlink_path *) arg;
+  mixlink_pipeline_t * pipeline = path->pipeline;
+
+  while( __atomic_load_n( &pipeline->running, __ATOMIC_ACQUIRE ) ){
+    // The other thread may have reopened a shared serial port
+    if( path->revive && mixlink_controller_gen( path->dir, pipeline->controller ) != path->gen )
+      path_resync( path );
+
+    // Drain from the sink backwards so every stage finds room downstream
+    size_t work = path_sink( path );
+
+    // Stages holding buffers until the sink makes progress, e.g., a scheduler, run once with no input
+    for( uint8_t i = 0 ; work && i < path->nstages ; ++i )
+      if( path->drain[i] ){
+        path->drain[i] = false;
+        path->stage[i].kick = true;
+      }
+
+    for( uint8_t i = path->nstages ; i-- ; )
+      work += path_stage( path, i );
+
+    work += path_source( path );
+
+    if( path->paused && mixlink_ring_space( &path->ring[0] ) ){
+      (void) mixlink_reactor_watch( path->source, EPOLLIN );
+      path->paused = false;
+    }
+
+    // While there is work only poll, otherwise sleep until the source, a stage timer or a stop request fires
+    if( -1 == mixlink_reactor_wait( &path->reactor, work ? 0 : -1 ) ){
+      error_print( "mixlink_reactor_wait" );
+      break;
+    }
+  }
+
+  return NULL;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_pipeline_init(
+  mixlink_pipeline_t * pipeline,
+  mixlink_translator_t * translator,
+  mixlink_controller_t * controller
+){
+  if( !pipeline || !translator || !controller ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  (void) memset( pipeline, 0, sizeof(mixlink_pipeline_t) );
+  pipeline->translator = translator;
+  pipeline->controller = controller;
+
+  if( -1 == path_build( &pipeline->tx, MIXLINK_DIRECTION_FROM_NIC, pipeline ) )
+    return -1;
+
+  if( -1 == path_build( &pipeline->rx, MIXLINK_DIRECTION_TO_NIC, pipeline ) ){
+    for( uint8_t i = 0 ; i <= pipeline->tx.nstages ; ++i )
+      mixlink_ring_free( &pipeline->tx.ring[i] );
+    mixlink_reactor_close( &pipeline->tx.reactor );
+    return -1;
+  }
+
+  // Both directions hold the same stages in opposite orders, e.g., an ARQ receiver wakes its sender to acknowledge
+  const uint8_t n = pipeline->tx.nstages;
+  for( uint8_t i = 0 ; i < n ; ++i ){
+    pipeline->tx.stage[i].reverse = pipeline->rx.stage[ n - 1 - i ].timer;
+    pipeline->rx.stage[ n - 1 - i ].reverse = pipeline->tx.stage[i].timer;
+  }
+
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_pipeline_start(
+  mixlink_pipeline_t * pipeline
+){
+  if( !pipeline ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  __atomic_store_n( &pipeline->running, true, __ATOMIC_RELEASE );
+
+  struct mixlink_path * paths[ ] = { &pipeline->tx, &pipeline->rx };
+  for( uint8_t i = 0 ; i < 2 ; ++i ){
+    const int ret = pthread_create( &paths[i]->thread, NULL, path_run, paths[i] );
+    if( 0 != ret ){
+      errno = ret;
+      (void) mixlink_pipeline_stop( pipeline );
+      return -1;
+    }
+    paths[i]->started = true;
+  }
+
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_pipeline_stop(
+  mixlink_pipeline_t * pipeline
+){
+  if( !pipeline ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  __atomic_store_n( &pipeline->running, false, __ATOMIC_RELEASE );
+
+  struct mixlink_path * paths[ ] = { &pipeline->tx, &pipeline->rx };
+  for( uint8_t i = 0 ; i < 2 ; ++i ){
+    if( paths[i]->started ){
+      (void) mixlink_reactor_wake( &paths[i]->reactor );
+      (void) pthread_join( paths[i]->thread, NULL );
+      paths[i]->started = false;
+    }
+  }
+
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_pipeline_close(
+  mixlink_pipeline_t * pipeline
+){
+  if( !pipeline )
+    return;
+
+  struct mixlink_path * paths[ ] = { &pipeline->tx, &pipeline->rx };
+  for( uint8_t i = 0 ; i < 2 ; ++i ){
+    for( uint8_t k = 0 ; k <= paths[i]->nstages ; ++k )
+      mixlink_ring_free( &paths[i]->ring[k] );
+    mixlink_reactor_close( &paths[i]->reactor );
+  }
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
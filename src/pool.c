@@ -0,0 +1,128 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      pool.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Preallocated pool of packet buffers with headroom and tailroom.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "pool.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_pool_init(
+  mixlink_pool_t * pool,
+  const size_t count,
+  const size_t bufsize,
+  const size_t headroom,
+  const size_t tailroom
+){
+  if( !pool || !count || !bufsize ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  (void) memset( pool, 0, sizeof(mixlink_pool_t) );
+
+  pool->buf = calloc( count, sizeof(mixlink_buf8_t) );
+
+  // Round each buffer up to a cache line so neighbouring buffers never share one
+  const size_t stride = ( headroom + bufsize + tailroom + MIXLINK_CACHE_LINE - 1 ) & ~((size_t) MIXLINK_CACHE_LINE - 1);
+  if( !pool->buf || 0 != posix_memalign( (void **) &pool->mem, MIXLINK_CACHE_LINE, count * stride ) ){
+    free( pool->buf );
+    (void) memset( pool, 0, sizeof(mixlink_pool_t) );
+    errno = ENOMEM;
+    return -1;
+  }
+
+  pool->count    = count;
+  pool->stride   = stride;
+  pool->headroom = headroom;
+  pool->bufsize  = bufsize + tailroom;
+
+  for( size_t i = 0 ; i < count ; ++i )
+    mixlink_pool_reset( pool, &pool->buf[i] );
+
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_pool_free(
+  mixlink_pool_t * pool
+){
+  if( !pool )
+    return;
+
+  free( pool->mem );
+  free( pool->buf );
+  (void) memset( pool, 0, sizeof(mixlink_pool_t) );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_pool_reset(
+  const mixlink_pool_t * pool,
+  mixlink_buf8_t * buf
+){
+  const size_t i = (size_t) ( buf - pool->buf );
+
+  buf->val  = &pool->mem[ i * pool->stride + pool->headroom ];
+  buf->len  = 0;
+  buf->size = pool->bufsize;
+  buf->head = pool->headroom;
+  buf->n_frag = 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+mixlink_buf8_iov(
+  const mixlink_buf8_t * buf,
+  struct iovec * iov
+){
+  size_t n = 0;
+
+  if( buf->len ){
+    iov[n].iov_base = buf->val;
+    iov[n].iov_len = buf->len;
+    n ++;
+  }
+
+  for( uint8_t i = 0 ; i < buf->n_frag ; ++i ){
+    iov[n].iov_base = buf->frag[i].val;
+    iov[n].iov_len = buf->frag[i].len;
+    n ++;
+  }
+
+  return n;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,797 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      prio.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Strict priority and deficit round robin scheduler of the `builtin:prio` sched stage, ahead of the serial writer.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: RFC 4594 (DiffServ service classes), Shreedhar and Varghese, Efficient Fair Queuing using Deficit Round Robin,
+ *            RFC 8289 (CoDel) and RFC 8290 (FQ-CoDel).
+ *
+ *            The stage is the first of the TX direction, so it still sees the IP and transport headers of every frame. It
+ *            classifies them by port rules, then by DSCP, and keeps them in a queue per flow of each class. Frames are let
+ *            through only while fewer than `depth` buffers wait between the scheduler and the serial port, so the backlog
+ *            builds up in the queues, where the order is still chosen, instead of in the rings after it; the core calls the
+ *            stage again every time the serial writer takes a buffer, which paces the scheduler at the rate the port
+ *            actually drains. The time a frame waited is measured when it leaves, so CoDel sees the delay of the radio and
+ *            not the one of the NIC.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "prio.h"
+#include "crc.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define PRIO_ETH_LEN  14
+#define PRIO_TCP      6
+#define PRIO_UDP      17
+#define PRIO_NIL      0xFFFF                                                   //!< End of a list of frames or flows
+#define PRIO_NEW      0                                                        //!< List of the flows that just became active
+#define PRIO_OLD      1
+#define PRIO_NONE     2                                                        //!< The flow is in no list
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+typedef struct{
+  uint64_t time;                                                               //!< When the frame was queued, in ms
+  uint16_t len;
+  uint16_t ip;                                                                 //!< Offset of the IP header, `PRIO_NIL` if the frame is not IP
+  uint16_t next;                                                               //!< Next frame of the flow, or of the free list
+  uint8_t data[ MIXLINK_PRIO_FRAME_MAX ];
+} prio_frame_t;
+
+typedef struct{
+  uint16_t head;                                                               //!< Oldest frame, `PRIO_NIL` when the flow is empty
+  uint16_t tail;
+  uint32_t bytes;
+  int32_t deficit;
+  uint16_t next;                                                               //!< Next flow of the list it is in
+  uint8_t list;
+
+  bool dropping;                                                               //!< CoDel is dropping, one frame every `drop_next`
+  uint32_t count;                                                              //!< Frames dropped since `dropping` was set
+  uint32_t last;                                                               //!< `count` when `dropping` was last set
+  uint64_t above;                                                              //!< When the frames may be dropped if they keep waiting more than `target`, 0 while they do not
+  uint64_t drop_next;
+} prio_flow_t;
+
+typedef struct{
+  prio_flow_t flow[ MIXLINK_PRIO_FLOWS ];
+  struct{
+    uint16_t head;
+    uint16_t tail;
+  } list[ 2 ];                                                                 //!< `PRIO_NEW` then `PRIO_OLD`, the flows with frames are always in one of them
+  int32_t deficit;                                                             //!< Bytes the class may still send in this round
+  uint32_t frames;
+} prio_class_t;
+
+typedef struct{
+  uint8_t l2;                                                                  //!< Bytes before the IP header, from the argument `eth`
+  uint8_t strict;
+  uint32_t quantum;
+  uint32_t depth;
+  uint64_t target;
+  uint64_t interval;
+  bool ecn;
+  uint16_t mtu;                                                                //!< Longest frame seen, a flow holding less is never dropped
+
+  struct{
+    uint16_t port;                                                             //!< Source or destination port
+    uint8_t cls;
+  } rule[ MIXLINK_PRIO_RULES ];
+  uint8_t nrules;
+
+  uint8_t turn;                                                                //!< Class whose round robin turn it is
+  bool granted;                                                                //!< `turn` already received its quantum in this turn
+  prio_class_t cls[ MIXLINK_PRIO_CLASSES ];
+
+  uint16_t free;                                                               //!< First unused frame of `pool`
+  prio_frame_t pool[ MIXLINK_PRIO_POOL ];
+} prio_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+uint64_t prio_now(
+  void
+);
+
+uint64_t prio_isqrt(
+  const uint64_t value
+);
+
+int8_t prio_rules(
+  prio_t * prio,
+  const char * args
+);
+
+uint8_t prio_classify(
+  const prio_t * prio,
+  const uint8_t * frame,
+  const size_t len,
+  uint16_t * ip,
+  uint32_t * hash
+);
+
+void prio_list_push(
+  prio_class_t * cls,
+  const uint8_t list,
+  const uint16_t idx
+);
+
+void prio_list_pop(
+  prio_class_t * cls,
+  const uint8_t list
+);
+
+void prio_push(
+  prio_t * prio,
+  prio_class_t * cls,
+  prio_flow_t * flow,
+  const uint16_t slot
+);
+
+uint16_t prio_pop(
+  prio_t * prio,
+  prio_class_t * cls,
+  prio_flow_t * flow
+);
+
+void prio_release(
+  prio_t * prio,
+  const uint16_t slot
+);
+
+void prio_evict(
+  prio_t * prio
+);
+
+bool prio_mark(
+  prio_t * prio,
+  const uint16_t slot
+);
+
+bool prio_ok(
+  const prio_t * prio,
+  prio_flow_t * flow,
+  const uint16_t slot,
+  const uint64_t now
+);
+
+uint64_t prio_law(
+  const prio_t * prio,
+  const uint64_t time,
+  const uint32_t count
+);
+
+uint16_t prio_codel(
+  prio_t * prio,
+  prio_class_t * cls,
+  prio_flow_t * flow,
+  const uint64_t now
+);
+
+uint16_t prio_fq(
+  prio_t * prio,
+  prio_class_t * cls,
+  const uint64_t now
+);
+
+int8_t prio_pick(
+  prio_t * prio
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+prio_now(
+  void
+){
+  struct timespec ts;
+  (void) clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint64_t) ts.tv_sec * 1000u + (uint64_t) ts.tv_nsec / 1000000u;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+prio_isqrt(
+  const uint64_t value
+){
+  uint64_t root = value;
+  uint64_t next = ( root + 1 ) / 2;
+  while( next < root ){
+    root = next;
+    next = ( root + value / root ) / 2;
+  }
+  return root;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+prio_rules(
+  prio_t * prio,
+  const char * args
+){
+  char list[ 256 ];
+  if( !mixlink_abi_arg_str( args, "ports", list, sizeof(list) ) )
+    return 0;
+
+  for( char * at = list ; *at ; ){
+    char * end;
+    const long port = strtol( at, &end, 10 );
+    if( ':' != *end || 0 >= port || 0xFFFF < port || MIXLINK_PRIO_RULES == prio->nrules )
+      return -1;
+
+    at = end + 1;
+    const long cls = strtol( at, &end, 10 );
+    if( end == at || 0 > cls || MIXLINK_PRIO_CLASSES <= cls || ( *end && ',' != *end ) )
+      return -1;
+
+    prio->rule[ prio->nrules ].port = (uint16_t) port;
+    prio->rule[ prio->nrules ++ ].cls = (uint8_t) cls;
+    at = *end ? end + 1 : end;
+  }
+
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint8_t
+prio_classify(
+  const prio_t * prio,
+  const uint8_t * frame,
+  const size_t len,
+  uint16_t * ip,
+  uint32_t * hash
+){
+  *ip = PRIO_NIL;
+  *hash = 0;
+
+  size_t at = prio->l2;
+  if( PRIO_ETH_LEN == at ){
+    if( len < PRIO_ETH_LEN )
+      return MIXLINK_PRIO_CONTROL;
+
+    // A VLAN tag moves the ethertype, its priority bits are left to the DSCP
+    uint16_t type = (uint16_t) ( frame[12] << 8 | frame[13] );
+    if( 0x8100 == type && len >= PRIO_ETH_LEN + 4 ){
+      type = (uint16_t) ( frame[16] << 8 | frame[17] );
+      at += 4;
+    }
+    if( 0x0800 != type && 0x86DD != type )
+      return MIXLINK_PRIO_CONTROL;
+  }
+
+  if( len < at + 20 )
+    return MIXLINK_PRIO_CONTROL;
+
+  // The flow is hashed from the addresses, the protocol and the ports
+  uint8_t key[ 32 + 1 + 4 ];
+  size_t nkey;
+  uint8_t dscp, proto;
+  size_t l4;
+  bool first = true;                                                           //!< The frame holds the transport header, not a later fragment
+  if( 4 == frame[ at ] >> 4 ){
+    dscp  = frame[ at + 1 ] >> 2;
+    proto = frame[ at + 9 ];
+    l4    = at + (size_t) ( frame[ at ] & 0x0F ) * 4u;
+    first = !( ( frame[ at + 6 ] << 8 | frame[ at + 7 ] ) & 0x1FFF );
+    nkey  = 8;
+    (void) memcpy( key, &frame[ at + 12 ], nkey );
+  }
+  else if( 6 == frame[ at ] >> 4 && len >= at + 40 ){
+    dscp  = (uint8_t) ( ( frame[ at ] & 0x0F ) << 2 | frame[ at + 1 ] >> 6 );
+    proto = frame[ at + 6 ];
+    l4    = at + 40;
+    nkey  = 32;
+    (void) memcpy( key, &frame[ at + 8 ], nkey );
+  }
+  else
+    return MIXLINK_PRIO_CONTROL;
+
+  *ip = (uint16_t) at;
+  key[ nkey ++ ] = proto;
+
+  uint8_t cls = MIXLINK_PRIO_CLASSES;
+  if( first && ( PRIO_TCP == proto || PRIO_UDP == proto ) && len >= l4 + 4 ){
+    (void) memcpy( &key[ nkey ], &frame[ l4 ], 4 );
+    nkey += 4;
+
+    const uint16_t sport = (uint16_t) ( frame[ l4 ] << 8 | frame[ l4 + 1 ] );
+    const uint16_t dport = (uint16_t) ( frame[ l4 + 2 ] << 8 | frame[ l4 + 3 ] );
+    for( uint8_t i = 0 ; i < prio->nrules && MIXLINK_PRIO_CLASSES == cls ; ++i )
+      if( prio->rule[i].port == sport || prio->rule[i].port == dport )
+        cls = prio->rule[i].cls;
+  }
+  *hash = mixlink_crc32c( key, nkey );
+
+  if( MIXLINK_PRIO_CLASSES != cls )
+    return cls;
+
+  // RFC 4594 figure 3
+  switch( dscp ){
+    case 46: case 44: case 48: case 56:
+      return MIXLINK_PRIO_CONTROL;
+    case 40: case 32: case 34: case 36: case 38: case 24: case 26: case 28: case 30:
+      return MIXLINK_PRIO_INTERACTIVE;
+    case 8: case 10: case 12: case 14:
+      return MIXLINK_PRIO_BULK;
+    default:
+      return MIXLINK_PRIO_DEFAULT;
+  }
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+prio_list_push(
+  prio_class_t * cls,
+  const uint8_t list,
+  const uint16_t idx
+){
+  cls->flow[ idx ].list = list;
+  cls->flow[ idx ].next = PRIO_NIL;
+  if( PRIO_NIL == cls->list[ list ].head )
+    cls->list[ list ].head = idx;
+  else
+    cls->flow[ cls->list[ list ].tail ].next = idx;
+  cls->list[ list ].tail = idx;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+prio_list_pop(
+  prio_class_t * cls,
+  const uint8_t list
+){
+  prio_flow_t * flow = &cls->flow[ cls->list[ list ].head ];
+  cls->list[ list ].head = flow->next;
+  flow->list = PRIO_NONE;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+prio_push(
+  prio_t * prio,
+  prio_class_t * cls,
+  prio_flow_t * flow,
+  const uint16_t slot
+){
+  prio->pool[ slot ].next = PRIO_NIL;
+  if( PRIO_NIL == flow->head )
+    flow->head = slot;
+  else
+    prio->pool[ flow->tail ].next = slot;
+  flow->tail = slot;
+  flow->bytes += prio->pool[ slot ].len;
+  ++ cls->frames;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint16_t
+prio_pop(
+  prio_t * prio,
+  prio_class_t * cls,
+  prio_flow_t * flow
+){
+  const uint16_t slot = flow->head;
+  if( PRIO_NIL == slot )
+    return PRIO_NIL;
+
+  flow->head = prio->pool[ slot ].next;
+  flow->bytes -= prio->pool[ slot ].len;
+  -- cls->frames;
+  return slot;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+prio_release(
+  prio_t * prio,
+  const uint16_t slot
+){
+  prio->pool[ slot ].next = prio->free;
+  prio->free = slot;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+prio_evict(
+  prio_t * prio
+){
+  prio_class_t * fat_cls = NULL;
+  prio_flow_t * fat = NULL;
+  for( uint8_t c = 0 ; c < MIXLINK_PRIO_CLASSES ; ++c )
+    for( uint8_t f = 0 ; f < MIXLINK_PRIO_FLOWS ; ++f )
+      if( !fat || prio->cls[c].flow[f].bytes > fat->bytes ){
+        fat_cls = &prio->cls[c];
+        fat = &prio->cls[c].flow[f];
+      }
+
+  // The flow stays in its list, it is removed once found empty
+  prio_release( prio, prio_pop( prio, fat_cls, fat ) );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+prio_mark(
+  prio_t * prio,
+  const uint16_t slot
+){
+  prio_frame_t * frame = &prio->pool[ slot ];
+  if( !prio->ecn || PRIO_NIL == frame->ip )
+    return false;
+
+  uint8_t * ip = &frame->data[ frame->ip ];
+  if( 4 == ip[0] >> 4 ){
+    if( !( ip[1] & 0x03 ) )
+      return false;
+
+    // RFC 1624 incremental update of the header checksum
+    const uint16_t old = (uint16_t) ( ip[0] << 8 | ip[1] );
+    ip[1] |= 0x03;
+    uint32_t sum = (uint32_t) (uint16_t) ~( ip[10] << 8 | ip[11] ) + (uint16_t) ~old + (uint32_t) ( ip[0] << 8 | ip[1] );
+    sum = ( sum & 0xFFFF ) + ( sum >> 16 );
+    sum = ( sum & 0xFFFF ) + ( sum >> 16 );
+    ip[10] = (uint8_t) ( ~sum >> 8 );
+    ip[11] = (uint8_t) ~sum;
+    return true;
+  }
+
+  if( !( ip[1] & 0x30 ) )
+    return false;
+
+  ip[1] |= 0x30;
+  return true;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+prio_ok(
+  const prio_t * prio,
+  prio_flow_t * flow,
+  const uint16_t slot,
+  const uint64_t now
+){
+  if( now - prio->pool[ slot ].time < prio->target || flow->bytes <= prio->mtu ){
+    flow->above = 0;
+    return false;
+  }
+
+  if( !flow->above ){
+    flow->above = now + prio->interval;
+    return false;
+  }
+
+  return now >= flow->above;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+prio_law(
+  const prio_t * prio,
+  const uint64_t time,
+  const uint32_t count
+){
+  return time + prio->interval * 1000u / prio_isqrt( (uint64_t) count * 1000000u );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint16_t
+prio_codel(
+  prio_t * prio,
+  prio_class_t * cls,
+  prio_flow_t * flow,
+  const uint64_t now
+){
+  uint16_t slot = prio_pop( prio, cls, flow );
+  if( PRIO_NIL == slot ){
+    flow->dropping = false;
+    return PRIO_NIL;
+  }
+
+  const bool ok = prio_ok( prio, flow, slot, now );
+  if( flow->dropping ){
+    if( !ok )
+      flow->dropping = false;
+
+    // Drops speed up with the square root of their count until the delay is back under the target
+    while( flow->dropping && now >= flow->drop_next ){
+      ++ flow->count;
+      if( prio_mark( prio, slot ) ){
+        flow->drop_next = prio_law( prio, flow->drop_next, flow->count );
+        break;
+      }
+
+      prio_release( prio, slot );
+      slot = prio_pop( prio, cls, flow );
+      if( PRIO_NIL == slot ){
+        flow->dropping = false;
+        return PRIO_NIL;
+      }
+
+      if( !prio_ok( prio, flow, slot, now ) )
+        flow->dropping = false;
+      else
+        flow->drop_next = prio_law( prio, flow->drop_next, flow->count );
+    }
+  }
+  else if( ok ){
+    if( !prio_mark( prio, slot ) ){
+      prio_release( prio, slot );
+      slot = prio_pop( prio, cls, flow );
+    }
+
+    // Resumes near the last drop rate when the flow was dropping a short while ago
+    const uint32_t delta = flow->count - flow->last;
+    flow->count = ( 1 < delta && (int64_t) ( now - flow->drop_next ) < (int64_t) ( 16 * prio->interval ) ) ? delta : 1;
+    flow->last = flow->count;
+    flow->drop_next = prio_law( prio, now, flow->count );
+    flow->dropping = true;
+  }
+
+  return slot;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint16_t
+prio_fq(
+  prio_t * prio,
+  prio_class_t * cls,
+  const uint64_t now
+){
+  for( ;; ){
+    const uint8_t list = ( PRIO_NIL != cls->list[ PRIO_NEW ].head ) ? PRIO_NEW : PRIO_OLD;
+    const uint16_t idx = cls->list[ list ].head;
+    if( PRIO_NIL == idx )
+      return PRIO_NIL;
+
+    prio_flow_t * flow = &cls->flow[ idx ];
+    if( 0 >= flow->deficit ){
+      flow->deficit += (int32_t) prio->quantum;
+      prio_list_pop( cls, list );
+      prio_list_push( cls, PRIO_OLD, idx );
+      continue;
+    }
+
+    const uint16_t slot = prio_codel( prio, cls, flow, now );
+    if( PRIO_NIL == slot ){
+      // A new flow that emptied goes behind the old ones, so it cannot take the new list again at once
+      prio_list_pop( cls, list );
+      if( PRIO_NEW == list )
+        prio_list_push( cls, PRIO_OLD, idx );
+      continue;
+    }
+
+    flow->deficit -= prio->pool[ slot ].len;
+    return slot;
+  }
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+prio_pick(
+  prio_t * prio
+){
+  for( uint8_t c = 0 ; c < prio->strict ; ++c )
+    if( prio->cls[c].frames )
+      return (int8_t) c;
+
+  bool any = false;
+  for( uint8_t c = prio->strict ; c < MIXLINK_PRIO_CLASSES ; ++c )
+    any |= ( 0 != prio->cls[c].frames );
+  if( !any )
+    return -1;
+
+  // Every turn adds a quantum, so a class with frames is served after a bounded number of turns
+  for( ;; ){
+    prio_class_t * cls = &prio->cls[ prio->turn ];
+    if( cls->frames ){
+      if( !prio->granted ){
+        cls->deficit += (int32_t) ( prio->quantum * (uint32_t) ( MIXLINK_PRIO_CLASSES - prio->turn ) );
+        prio->granted = true;
+      }
+
+      if( 0 < cls->deficit )
+        return (int8_t) prio->turn;
+    }
+    else
+      cls->deficit = 0;
+
+    prio->turn = (uint8_t) ( prio->turn + 1 < MIXLINK_PRIO_CLASSES ? prio->turn + 1 : prio->strict );
+    prio->granted = false;
+  }
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_prio_init(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  if( def->priv )
+    return 0;
+
+  const long strict = mixlink_abi_arg( def->args, "strict", MIXLINK_PRIO_STRICT );
+  const long quantum = mixlink_abi_arg( def->args, "quantum", MIXLINK_PRIO_QUANTUM );
+  const long depth = mixlink_abi_arg( def->args, "depth", MIXLINK_PRIO_DEPTH );
+  const long target = mixlink_abi_arg( def->args, "target", MIXLINK_PRIO_TARGET );
+  const long interval = mixlink_abi_arg( def->args, "interval", MIXLINK_PRIO_INTERVAL );
+  if( 0 > strict || MIXLINK_PRIO_CLASSES < strict || 0 >= quantum || MIXLINK_PRIO_FRAME_MAX < quantum || 0 >= depth || MIXLINK_PRIO_POOL < depth ){
+    errno = EINVAL;
+    return -1;
+  }
+  if( 0 >= target || 0 >= interval || 600000 < interval ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  prio_t * prio = calloc( 1, sizeof(prio_t) );
+  if( !prio )
+    return -1;
+
+  if( -1 == prio_rules( prio, def->args ) ){
+    free( prio );
+    errno = EINVAL;
+    return -1;
+  }
+
+  prio->l2       = mixlink_abi_arg( def->args, "eth", 1 ) ? PRIO_ETH_LEN : 0;
+  prio->strict   = (uint8_t) strict;
+  prio->quantum  = (uint32_t) quantum;
+  prio->depth    = (uint32_t) depth;
+  prio->target   = (uint64_t) target;
+  prio->interval = (uint64_t) interval;
+  prio->ecn      = 0 != mixlink_abi_arg( def->args, "ecn", 1 );
+  prio->turn     = ( MIXLINK_PRIO_CLASSES > strict ) ? (uint8_t) strict : 0;
+
+  for( uint8_t c = 0 ; c < MIXLINK_PRIO_CLASSES ; ++c ){
+    prio_class_t * cls = &prio->cls[c];
+    cls->list[ PRIO_NEW ].head = cls->list[ PRIO_OLD ].head = PRIO_NIL;
+    for( uint8_t f = 0 ; f < MIXLINK_PRIO_FLOWS ; ++f ){
+      cls->flow[f].head = PRIO_NIL;
+      cls->flow[f].list = PRIO_NONE;
+    }
+  }
+  for( uint16_t i = 0 ; i < MIXLINK_PRIO_POOL ; ++i )
+    prio->pool[i].next = (uint16_t) ( i + 1 < MIXLINK_PRIO_POOL ? i + 1 : PRIO_NIL );
+
+  def->priv = prio;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_prio_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  free( def->priv );
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_prio_tx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  prio_t * prio = (prio_t *) abi->priv;
+  const uint64_t now = prio_now();
+
+  if( abi->n_in ){
+    const mixlink_buf8_t * in = abi->in[0];
+    if( MIXLINK_PRIO_FRAME_MAX < in->len ){
+      errno = EMSGSIZE;
+      return -1;
+    }
+
+    uint16_t ip;
+    uint32_t hash;
+    prio_class_t * cls = &prio->cls[ prio_classify( prio, in->val, in->len, &ip, &hash ) ];
+    if( PRIO_NIL == prio->free )
+      prio_evict( prio );
+
+    const uint16_t slot = prio->free;
+    prio_frame_t * frame = &prio->pool[ slot ];
+    prio->free = frame->next;
+    frame->time = now;
+    frame->len  = (uint16_t) in->len;
+    frame->ip   = ip;
+    (void) memcpy( frame->data, in->val, in->len );
+    if( frame->len > prio->mtu )
+      prio->mtu = frame->len;
+
+    const uint16_t idx = (uint16_t) ( hash & ( MIXLINK_PRIO_FLOWS - 1 ) );
+    prio_flow_t * flow = &cls->flow[ idx ];
+    prio_push( prio, cls, flow, slot );
+    if( PRIO_NONE == flow->list ){
+      flow->deficit = (int32_t) prio->quantum;
+      prio_list_push( cls, PRIO_NEW, idx );
+    }
+  }
+
+  uint8_t n = 0;
+  for( uint32_t backlog = abi->backlog ; n < abi->n_out && backlog < prio->depth ; ){
+    const int8_t c = prio_pick( prio );
+    if( -1 == c )
+      break;
+
+    // None when CoDel dropped what was left of the class
+    const uint16_t slot = prio_fq( prio, &prio->cls[ c ], now );
+    if( PRIO_NIL == slot )
+      continue;
+
+    const prio_frame_t * frame = &prio->pool[ slot ];
+    mixlink_buf8_t * out = abi->out[ n ];
+    if( out->size < frame->len ){
+      prio_release( prio, slot );
+      errno = EMSGSIZE;
+      return -1;
+    }
+
+    (void) memcpy( out->val, frame->data, frame->len );
+    out->len = frame->len;
+    if( c >= prio->strict )
+      prio->cls[ c ].deficit -= frame->len;
+    prio_release( prio, slot );
+    ++ n;
+    ++ backlog;
+  }
+
+  // What is left goes once the serial port has taken a buffer
+  for( uint8_t c = 0 ; c < MIXLINK_PRIO_CLASSES ; ++c )
+    abi->drain |= ( 0 != prio->cls[c].frames );
+
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,299 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      reactor.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Event loop based on epoll and timerfd.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "reactor.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+int8_t reactor_drain(
+  mixlink_event_t * ev,
+  const uint32_t events
+);
+
+mixlink_event_t * reactor_slot(
+  mixlink_reactor_t * reactor
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+reactor_drain(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  (void) events;
+
+  uint64_t count;
+  (void) read( ev->fd, &count, sizeof(count) );
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+mixlink_event_t *
+reactor_slot(
+  mixlink_reactor_t * reactor
+){
+  if( MIXLINK_REACTOR_MAX_EVENTS <= reactor->nev ){
+    errno = ENOSPC;
+    return NULL;
+  }
+
+  mixlink_event_t * ev = &reactor->ev[ reactor->nev ];
+  (void) memset( ev, 0, sizeof(mixlink_event_t) );
+  ev->reactor = reactor;
+  return ev;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_reactor_init(
+  mixlink_reactor_t * reactor
+){
+  if( !reactor ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  (void) memset( reactor, 0, sizeof(mixlink_reactor_t) );
+
+  reactor->epfd = epoll_create1( EPOLL_CLOEXEC );
+  if( 0 > reactor->epfd )
+    return -1;
+
+  reactor->wake.fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+  if( 0 > reactor->wake.fd ){
+    (void) close( reactor->epfd );
+    return -1;
+  }
+  reactor->wake.fn = reactor_drain;
+  reactor->wake.reactor = reactor;
+
+  struct epoll_event ee = { .events = EPOLLIN, .data.ptr = &reactor->wake };
+  if( -1 == epoll_ctl( reactor->epfd, EPOLL_CTL_ADD, reactor->wake.fd, &ee ) ){
+    (void) close( reactor->wake.fd );
+    (void) close( reactor->epfd );
+    return -1;
+  }
+
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_reactor_close(
+  mixlink_reactor_t * reactor
+){
+  if( !reactor )
+    return;
+
+  for( uint8_t i = 0 ; i < reactor->nev ; ++i )
+    if( reactor->ev[i].timer )
+      (void) close( reactor->ev[i].fd );
+
+  (void) close( reactor->wake.fd );
+  (void) close( reactor->epfd );
+  reactor->nev = 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+mixlink_event_t *
+mixlink_reactor_add_fd(
+  mixlink_reactor_t * reactor,
+  const int fd,
+  const uint32_t events,
+  mixlink_event_fn_t fn,
+  void * arg
+){
+  if( !reactor || 0 > fd || !fn ){
+    errno = EINVAL;
+    return NULL;
+  }
+
+  mixlink_event_t * ev = reactor_slot( reactor );
+  if( !ev )
+    return NULL;
+
+  ev->fd  = fd;
+  ev->fn  = fn;
+  ev->arg = arg;
+
+  struct epoll_event ee = { .events = events, .data.ptr = ev };
+  if( -1 == epoll_ctl( reactor->epfd, EPOLL_CTL_ADD, fd, &ee ) )
+    return NULL;
+
+  reactor->nev ++;
+  return ev;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+mixlink_event_t *
+mixlink_reactor_add_timer(
+  mixlink_reactor_t * reactor,
+  mixlink_event_fn_t fn,
+  void * arg
+){
+  if( !reactor || !fn ){
+    errno = EINVAL;
+    return NULL;
+  }
+
+  const int fd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+  if( 0 > fd )
+    return NULL;
+
+  mixlink_event_t * ev = mixlink_reactor_add_fd( reactor, fd, EPOLLIN, fn, arg );
+  if( !ev ){
+    (void) close( fd );
+    return NULL;
+  }
+
+  ev->timer = true;
+  return ev;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_reactor_watch(
+  mixlink_event_t * ev,
+  const uint32_t events
+){
+  if( !ev || !ev->reactor || 0 > ev->fd ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  struct epoll_event ee = { .events = events, .data.ptr = ev };
+  return (int8_t) epoll_ctl( ev->reactor->epfd, EPOLL_CTL_MOD, ev->fd, &ee );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_reactor_rebind(
+  mixlink_event_t * ev,
+  const int fd,
+  const uint32_t events
+){
+  if( !ev || !ev->reactor || ev->timer ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  // Closing the old descriptor may already have removed it, and the new one may reuse its number
+  if( 0 <= ev->fd )
+    (void) epoll_ctl( ev->reactor->epfd, EPOLL_CTL_DEL, ev->fd, NULL );
+
+  ev->fd = fd;
+  if( 0 > fd )
+    return 0;
+
+  struct epoll_event ee = { .events = events, .data.ptr = ev };
+  if( -1 == epoll_ctl( ev->reactor->epfd, EPOLL_CTL_ADD, fd, &ee ) ){
+    ev->fd = -1;
+    return -1;
+  }
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_reactor_schedule(
+  void * ctx,
+  const uint32_t ms
+){
+  mixlink_event_t * ev = (mixlink_event_t *) ctx;
+  if( !ev || !ev->timer ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  // A zeroed it_value disarms the timer, so "now" is the smallest possible deadline
+  struct itimerspec its;
+  (void) memset( &its, 0, sizeof(its) );
+  its.it_value.tv_sec  = (time_t) ( ms / 1000 );
+  its.it_value.tv_nsec = ms ? (long) ( ms % 1000 ) * 1000000L : 1L;
+
+  return (int8_t) timerfd_settime( ev->fd, 0, &its, NULL );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int
+mixlink_reactor_wait(
+  mixlink_reactor_t * reactor,
+  const int timeout
+){
+  if( !reactor ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  struct epoll_event ready[ MIXLINK_REACTOR_MAX_EVENTS ];
+  const int n = epoll_wait( reactor->epfd, ready, MIXLINK_REACTOR_MAX_EVENTS, timeout );
+  if( 0 > n )
+    return ( EINTR == errno ) ? 0 : -1;
+
+  int8_t ret = 0;
+  for( int i = 0 ; i < n ; ++i ){
+    mixlink_event_t * ev = (mixlink_event_t *) ready[i].data.ptr;
+
+    if( ev->timer )
+      (void) reactor_drain( ev, ready[i].events );
+
+    if( -1 == ev->fn( ev, ready[i].events ) )
+      ret = -1;
+  }
+
+  return ( -1 == ret ) ? -1 : n;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_reactor_wake(
+  mixlink_reactor_t * reactor
+){
+  if( !reactor ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  const uint64_t one = 1;
+  return ( (ssize_t) sizeof(one) == write( reactor->wake.fd, &one, sizeof(one) ) ) ? 0 : -1;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
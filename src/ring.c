@@ -0,0 +1,170 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      ring.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Lock-free single-producer/single-consumer ring used between the pipeline stages.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals:
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "ring.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_ring_init(
+  mixlink_ring_t * ring,
+  const size_t slots,
+  const size_t bufsize
+){
+  if( !ring || !slots || !bufsize || ( slots & (slots - 1) ) ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  (void) memset( ring, 0, sizeof(mixlink_ring_t) );
+
+  // Slots are recycled in order, so the pool only provides the memory and the descriptors
+  if( -1 == mixlink_pool_init( &ring->pool, slots, bufsize, MIXLINK_BUF_HEADROOM, MIXLINK_BUF_TAILROOM ) )
+    return -1;
+
+  ring->slot    = ring->pool.buf;
+  ring->mask    = slots - 1;
+  ring->bufsize = bufsize;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_ring_free(
+  mixlink_ring_t * ring
+){
+  if( !ring )
+    return;
+
+  mixlink_pool_free( &ring->pool );
+  ring->slot = NULL;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+mixlink_ring_space(
+  mixlink_ring_t * ring
+){
+  const size_t head = ring->head;
+  size_t used = head - ring->tail_cache;
+
+  // Only refresh once the cached view could limit a stage that fans out to every port
+  if( ring->mask + 1 - used < MIXLINK_MODULE_MAX_PORTS ){
+    ring->tail_cache = __atomic_load_n( &ring->tail, __ATOMIC_ACQUIRE );
+    used = head - ring->tail_cache;
+  }
+
+  return ring->mask + 1 - used;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+mixlink_buf8_t *
+mixlink_ring_reserve(
+  mixlink_ring_t * ring,
+  const size_t idx
+){
+  if( idx >= mixlink_ring_space( ring ) )
+    return NULL;
+
+  mixlink_buf8_t * buf = &ring->slot[ (ring->head + idx) & ring->mask ];
+  mixlink_pool_reset( &ring->pool, buf );
+  return buf;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_ring_commit(
+  mixlink_ring_t * ring,
+  const size_t n
+){
+  __atomic_store_n( &ring->head, ring->head + n, __ATOMIC_RELEASE );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+mixlink_ring_count(
+  mixlink_ring_t * ring
+){
+  const size_t tail = ring->tail;
+  size_t avail = ring->head_cache - tail;
+
+  if( !avail ){
+    ring->head_cache = __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE );
+    avail = ring->head_cache - tail;
+  }
+
+  return avail;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+mixlink_buf8_t *
+mixlink_ring_front(
+  mixlink_ring_t * ring
+){
+  if( !mixlink_ring_count( ring ) )
+    return NULL;
+
+  return &ring->slot[ ring->tail & ring->mask ];
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+mixlink_buf8_t *
+mixlink_ring_peek(
+  mixlink_ring_t * ring,
+  const size_t idx
+){
+  size_t avail = mixlink_ring_count( ring );
+
+  if( idx >= avail ){
+    ring->head_cache = __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE );
+    avail = ring->head_cache - ring->tail;
+  }
+
+  if( idx >= avail )
+    return NULL;
+
+  return &ring->slot[ (ring->tail + idx) & ring->mask ];
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_ring_release(
+  mixlink_ring_t * ring,
+  const size_t n
+){
+  __atomic_store_n( &ring->tail, ring->tail + n, __ATOMIC_RELEASE );
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
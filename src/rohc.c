@@ -0,0 +1,739 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      rohc.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Context-based IPv4/IPv6 TCP/UDP header compressor of the `builtin:rohc` opt stage.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: RFC 3095 and RFC 6846 (ROHC), RFC 6282 (IPHC).
+ *
+ *            A flow is every header field that does not change between its packets, the Ethernet header included, and
+ *            it is found through a hash table keyed by those fields. Both sides keep the last header of each flow, so
+ *            only the fields that did not follow it are sent, lengths and the IPv4 checksum are recomputed from the
+ *            frame. As in the unidirectional mode of ROHC there is no feedback, so the receiver drops a header whose
+ *            CRC does not match and the contexts are sent in full every `MIXLINK_ROHC_REFRESH` packets.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "rohc.h"
+#include "crc.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Macros
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#define ROHC_ETH_LEN  14
+#define ROHC_L2_MAX   32                                                       //!< Longest link header, an IPv6 TCP header with options must still fit
+#define ROHC_TCP      6
+#define ROHC_UDP      17
+#define ROHC_MASK16   0xFFFFu
+#define ROHC_MASK32   0xFFFFFFFFu
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Enumerations
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Fields of a header that change within a flow, the others belong to its context
+enum rohc_field{
+  ROHC_IPID = 0,
+  ROHC_TSV,
+  ROHC_TSE,
+  ROHC_SEQ,
+  ROHC_ACK,
+  ROHC_WIN,
+  ROHC_FLAGS,
+  ROHC_FIELDS,
+};
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Where the headers of a frame are
+typedef struct{
+  uint8_t ip;                                                                  //!< Offset of the IP header, after the link header
+  uint8_t ver;
+  uint8_t l4;                                                                  //!< Offset of the TCP or UDP header
+  uint8_t proto;
+  uint8_t len;                                                                 //!< Bytes of every header, the payload starts here
+  uint16_t end;                                                                //!< Bytes of the frame without the link padding
+  bool ts;                                                                     //!< The TCP options are NOP, NOP and a timestamp
+  bool udp_csum;                                                               //!< The UDP checksum is in use
+} rohc_info_t;
+
+//!< A flow, the compressor and the decompressor hold the same one for the same identifier
+typedef struct{
+  bool valid;
+  rohc_info_t info;
+  uint8_t hdr[ MIXLINK_ROHC_HDR_MAX ];                                         //!< Last header rebuilt, decompressor only
+  uint8_t key[ MIXLINK_ROHC_HDR_MAX ];                                         //!< The header with the changing fields cleared, compressor only
+  uint32_t ref[ MIXLINK_ROHC_WINDOW ][ ROHC_FIELDS ];                          //!< Changing fields of the last headers sent, compressor only, the decompressor holds one of them
+  uint8_t nref;
+  uint8_t next;                                                                //!< Slot of `ref` the next header takes
+  uint32_t count;                                                              //!< Compressed headers since the context was last sent in full
+  uint8_t full;                                                                //!< Full headers still to send before compressing a new flow
+  uint64_t used;                                                               //!< Compressor tick of the last packet, the least recent is replaced
+} rohc_ctx_t;
+
+typedef struct{
+  uint8_t l2;                                                                  //!< Bytes before the IP header, arguments `eth` and `l2`
+  uint64_t tick;
+  rohc_ctx_t tx[ MIXLINK_ROHC_CONTEXTS ];
+  rohc_ctx_t rx[ MIXLINK_ROHC_CONTEXTS ];
+} rohc_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+bool rohc_parse(
+  const uint8_t * frame,
+  const size_t len,
+  const uint8_t l2,
+  rohc_info_t * info
+);
+
+void rohc_key(
+  const uint8_t * hdr,
+  const rohc_info_t * info,
+  uint8_t * key
+);
+
+void rohc_finish(
+  uint8_t * hdr,
+  const rohc_info_t * info,
+  const size_t plen
+);
+
+size_t rohc_fields(
+  const rohc_info_t * info,
+  const uint8_t flags
+);
+
+void rohc_values(
+  const uint8_t * hdr,
+  const rohc_info_t * info,
+  uint32_t * val
+);
+
+bool rohc_fits(
+  const rohc_ctx_t * ctx,
+  const enum rohc_field field,
+  const uint32_t val,
+  const uint8_t k,
+  const uint32_t mask
+);
+
+uint32_t rohc_lsb(
+  const uint32_t ref,
+  const uint32_t lsb,
+  const uint8_t k,
+  const uint32_t mask
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Field helpers
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+static inline uint16_t
+get16(
+  const uint8_t * at
+){
+  return (uint16_t) ( at[0] << 8 | at[1] );
+}
+
+static inline uint32_t
+get32(
+  const uint8_t * at
+){
+  return (uint32_t) at[0] << 24 | (uint32_t) at[1] << 16 | (uint32_t) at[2] << 8 | at[3];
+}
+
+static inline void
+put16(
+  uint8_t * at,
+  const uint16_t val
+){
+  at[0] = (uint8_t) ( val >> 8 );
+  at[1] = (uint8_t) val;
+}
+
+static inline void
+put32(
+  uint8_t * at,
+  const uint32_t val
+){
+  put16( at, (uint16_t) ( val >> 16 ) );
+  put16( &at[2], (uint16_t) val );
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+rohc_parse(
+  const uint8_t * frame,
+  const size_t len,
+  const uint8_t l2,
+  rohc_info_t * info
+){
+  (void) memset( info, 0, sizeof(rohc_info_t) );
+  info->ip = l2;
+
+  if( len < (size_t) info->ip + 28u )
+    return false;
+
+  const uint8_t * ip = &frame[ info->ip ];
+  info->ver = ip[0] >> 4;
+  size_t end;
+
+  if( ROHC_ETH_LEN == l2 && get16( &frame[12] ) != ( 4 == info->ver ? 0x0800 : 0x86DD ) )
+    return false;
+
+  if( 4 == info->ver ){
+    // Options and fragments are rare enough to go uncompressed
+    if( 0x45 != ip[0] || get16( &ip[6] ) & 0x3FFF )
+      return false;
+    info->proto = ip[9];
+    info->l4 = (uint8_t) ( info->ip + 20 );
+    end = info->ip + (size_t) get16( &ip[2] );
+  }
+  else if( 6 == info->ver && len >= (size_t) info->ip + 48u ){
+    info->proto = ip[6];
+    info->l4 = (uint8_t) ( info->ip + 40 );
+    end = info->ip + 40u + get16( &ip[4] );
+  }
+  else
+    return false;
+
+  // A short frame may be padded by the link, the IP length tells where it ends
+  if( end > len || end < (size_t) info->l4 + 8u )
+    return false;
+  info->end = (uint16_t) end;
+
+  const uint8_t * l4 = &frame[ info->l4 ];
+  if( ROHC_UDP == info->proto ){
+    info->len = (uint8_t) ( info->l4 + 8 );
+    info->udp_csum = ( l4[6] | l4[7] );
+  }
+  else if( ROHC_TCP == info->proto ){
+    const size_t hl = (size_t) ( l4[12] >> 4 ) * 4u;
+    if( 20 > hl || end < info->l4 + hl || MIXLINK_ROHC_HDR_MAX < info->l4 + hl || ( l4[13] & 0x20 ) )
+      return false;
+    info->len = (uint8_t) ( info->l4 + hl );
+    info->ts = ( 32 == hl && 0x01 == l4[20] && 0x01 == l4[21] && 0x08 == l4[22] && 0x0A == l4[23] );
+  }
+  else
+    return false;
+
+  return true;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+rohc_key(
+  const uint8_t * hdr,
+  const rohc_info_t * info,
+  uint8_t * key
+){
+  (void) memcpy( key, hdr, info->len );
+  uint8_t * ip = &key[ info->ip ];
+  uint8_t * l4 = &key[ info->l4 ];
+
+  if( 4 == info->ver ){
+    (void) memset( &ip[2], 0, 4 );                                             // Length and identification
+    (void) memset( &ip[10], 0, 2 );                                            // Checksum
+  }
+  else
+    (void) memset( &ip[4], 0, 2 );                                             // Payload length
+
+  if( ROHC_TCP == info->proto ){
+    (void) memset( &l4[4], 0, 8 );                                             // Sequence and acknowledgement numbers
+    (void) memset( &l4[13], 0, 5 );                                            // Flags, window and checksum
+    if( info->ts )
+      (void) memset( &l4[24], 0, 8 );
+  }
+  else{
+    (void) memset( &l4[4], 0, 2 );
+    // Only whether the checksum is in use belongs to the flow
+    l4[6] = l4[7] = ( l4[6] | l4[7] ) ? 0xFF : 0;
+  }
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+rohc_finish(
+  uint8_t * hdr,
+  const rohc_info_t * info,
+  const size_t plen
+){
+  uint8_t * ip = &hdr[ info->ip ];
+  const size_t l3 = (size_t) info->len - info->ip + plen;
+
+  if( 4 == info->ver ){
+    put16( &ip[2], (uint16_t) l3 );
+    put16( &ip[10], 0 );
+    uint32_t sum = 0;
+    for( size_t i = 0 ; i < 20 ; i += 2 )
+      sum += get16( &ip[i] );
+    while( sum >> 16 )
+      sum = ( sum & 0xFFFF ) + ( sum >> 16 );
+    put16( &ip[10], (uint16_t) ~sum );
+  }
+  else
+    put16( &ip[4], (uint16_t) ( l3 - 40 ) );
+
+  if( ROHC_UDP == info->proto )
+    put16( &hdr[ info->l4 + 4 ], (uint16_t) ( 8 + plen ) );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+rohc_fields(
+  const rohc_info_t * info,
+  const uint8_t flags
+){
+  static const uint8_t bytes[8] = { 2, 4, 8, 2, 4, 2, 4, 3 };
+  size_t n = 0;
+  for( uint8_t i = 0 ; i < 8 ; ++i )
+    if( flags & ( 1u << i ) )
+      n += bytes[i];
+
+  // Without the flag the low byte of the IPv4 identification is sent
+  if( 4 == info->ver && !( flags & MIXLINK_ROHC_F_IPID ) )
+    n += 1;
+
+  // The TCP checksum is always sent, the UDP one when the flow has it
+  if( ROHC_TCP == info->proto || info->udp_csum )
+    n += 2;
+  return n;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+rohc_values(
+  const uint8_t * hdr,
+  const rohc_info_t * info,
+  uint32_t * val
+){
+  const uint8_t * ip = &hdr[ info->ip ];
+  const uint8_t * l4 = &hdr[ info->l4 ];
+  (void) memset( val, 0, ROHC_FIELDS * sizeof(uint32_t) );
+
+  if( 4 == info->ver )
+    val[ ROHC_IPID ] = get16( &ip[4] );
+
+  if( ROHC_TCP != info->proto )
+    return;
+
+  if( info->ts ){
+    val[ ROHC_TSV ] = get32( &l4[24] );
+    val[ ROHC_TSE ] = get32( &l4[28] );
+  }
+  val[ ROHC_SEQ ]   = get32( &l4[4] );
+  val[ ROHC_ACK ]   = get32( &l4[8] );
+  val[ ROHC_WIN ]   = get16( &l4[14] );
+  val[ ROHC_FLAGS ] = l4[13];
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+rohc_fits(
+  const rohc_ctx_t * ctx,
+  const enum rohc_field field,
+  const uint32_t val,
+  const uint8_t k,
+  const uint32_t mask
+){
+  // The interval of each reference starts a quarter below it, with `k` at 0 the value must equal every reference
+  const uint32_t span = (uint32_t) 1 << k;
+  const uint32_t below = span >> 2;
+  for( uint8_t i = 0 ; i < ctx->nref ; ++i )
+    if( ( ( val - ctx->ref[i][ field ] + below ) & mask ) >= span )
+      return false;
+  return true;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint32_t
+rohc_lsb(
+  const uint32_t ref,
+  const uint32_t lsb,
+  const uint8_t k,
+  const uint32_t mask
+){
+  const uint32_t span = (uint32_t) 1 << k;
+  const uint32_t base = ref - ( span >> 2 );
+  return ( base + ( ( lsb - base ) & ( span - 1 ) ) ) & mask;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_rohc_init(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  if( def->priv )
+    return 0;
+
+  rohc_t * rohc = calloc( 1, sizeof(rohc_t) );
+  if( !rohc )
+    return -1;
+
+  // Behind `builtin:eth` the Ethernet header is already a context byte and a check byte, "l2=2"
+  const long l2 = mixlink_abi_arg( def->args, "l2", mixlink_abi_arg( def->args, "eth", 1 ) ? ROHC_ETH_LEN : 0 );
+  if( 0 > l2 || ROHC_L2_MAX < l2 ){
+    free( rohc );
+    errno = EINVAL;
+    return -1;
+  }
+
+  rohc->l2 = (uint8_t) l2;
+  def->priv = rohc;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_rohc_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  free( def->priv );
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_rohc_tx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  rohc_t * rohc = (rohc_t *) abi->priv;
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+  if( out->size < in->len + 2 ){
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  abi->n_out = 1;
+  rohc_info_t info;
+  if( !rohc_parse( in->val, in->len, rohc->l2, &info ) ){
+    out->val[0] = MIXLINK_ROHC_RAW;
+    (void) memcpy( &out->val[1], in->val, in->len );
+    out->len = in->len + 1;
+    return 0;
+  }
+
+  uint8_t key[ MIXLINK_ROHC_HDR_MAX ];
+  rohc_key( in->val, &info, key );
+
+  // Open addressing over a few slots, a flow not found takes a free one or the least recently used of them
+  const uint32_t hash = mixlink_crc32c( key, info.len );
+  uint8_t cid = 0;
+  bool hit = false;
+  for( uint8_t i = 0 ; i < MIXLINK_ROHC_PROBE ; ++i ){
+    const uint8_t at = (uint8_t) ( ( hash + i ) & ( MIXLINK_ROHC_CONTEXTS - 1 ) );
+    const rohc_ctx_t * c = &rohc->tx[ at ];
+    if( c->valid && c->info.len == info.len && !memcmp( c->key, key, info.len ) ){
+      cid = at;
+      hit = true;
+      break;
+    }
+    if( !i || ( rohc->tx[ cid ].valid && ( !c->valid || c->used < rohc->tx[ cid ].used ) ) )
+      cid = at;
+  }
+
+  rohc_ctx_t * ctx = &rohc->tx[ cid ];
+  const size_t plen = info.end - info.len;
+  const uint8_t * hdr = in->val;
+  uint32_t val[ ROHC_FIELDS ];
+  rohc_values( hdr, &info, val );
+  ctx->used = ++ rohc->tick;
+
+  if( !hit )
+    ctx->full = MIXLINK_ROHC_OPTIMISTIC;
+
+  if( ctx->full || MIXLINK_ROHC_REFRESH <= ctx->count ){
+    out->val[0] = MIXLINK_ROHC_IR;
+    out->val[1] = cid;
+    (void) memcpy( &out->val[2], in->val, info.end );
+    out->len = info.end + 2u;
+
+    // A new flow starts its window, a refresh may be lost like any other packet and joins it
+    if( !hit )
+      ctx->nref = ctx->next = 0;
+    if( ctx->full )
+      ctx->full --;
+  }
+  else{
+    const uint8_t * l4 = &hdr[ info.l4 ];
+    uint8_t * o = out->val;
+    uint8_t flags = 0;
+    size_t at = 3;
+
+    if( 4 == info.ver ){
+      if( rohc_fits( ctx, ROHC_IPID, val[ ROHC_IPID ], 8, ROHC_MASK16 ) )
+        o[ at ++ ] = (uint8_t) val[ ROHC_IPID ];
+      else{
+        flags |= MIXLINK_ROHC_F_IPID;
+        put16( &o[ at ], (uint16_t) val[ ROHC_IPID ] );
+        at += 2;
+      }
+    }
+
+    if( ROHC_TCP == info.proto ){
+      if( info.ts && !( rohc_fits( ctx, ROHC_TSV, val[ ROHC_TSV ], 0, ROHC_MASK32 ) && rohc_fits( ctx, ROHC_TSE, val[ ROHC_TSE ], 0, ROHC_MASK32 ) ) ){
+        if( rohc_fits( ctx, ROHC_TSV, val[ ROHC_TSV ], 16, ROHC_MASK32 ) && rohc_fits( ctx, ROHC_TSE, val[ ROHC_TSE ], 16, ROHC_MASK32 ) ){
+          flags |= MIXLINK_ROHC_F_TS16;
+          put16( &o[ at ], (uint16_t) val[ ROHC_TSV ] );
+          put16( &o[ at + 2 ], (uint16_t) val[ ROHC_TSE ] );
+          at += 4;
+        }
+        else{
+          flags |= MIXLINK_ROHC_F_TS32;
+          (void) memcpy( &o[ at ], &l4[24], 8 );
+          at += 8;
+        }
+      }
+
+      if( !rohc_fits( ctx, ROHC_SEQ, val[ ROHC_SEQ ], 0, ROHC_MASK32 ) ){
+        const bool lsb = rohc_fits( ctx, ROHC_SEQ, val[ ROHC_SEQ ], 16, ROHC_MASK32 );
+        flags |= lsb ? MIXLINK_ROHC_F_SEQ16 : MIXLINK_ROHC_F_SEQ32;
+        if( lsb )
+          put16( &o[ at ], (uint16_t) val[ ROHC_SEQ ] );
+        else
+          (void) memcpy( &o[ at ], &l4[4], 4 );
+        at += lsb ? 2 : 4;
+      }
+
+      if( !rohc_fits( ctx, ROHC_ACK, val[ ROHC_ACK ], 0, ROHC_MASK32 ) ){
+        const bool lsb = rohc_fits( ctx, ROHC_ACK, val[ ROHC_ACK ], 16, ROHC_MASK32 );
+        flags |= lsb ? MIXLINK_ROHC_F_ACK16 : MIXLINK_ROHC_F_ACK32;
+        if( lsb )
+          put16( &o[ at ], (uint16_t) val[ ROHC_ACK ] );
+        else
+          (void) memcpy( &o[ at ], &l4[8], 4 );
+        at += lsb ? 2 : 4;
+      }
+
+      if( !rohc_fits( ctx, ROHC_WIN, val[ ROHC_WIN ], 0, ROHC_MASK16 ) || !rohc_fits( ctx, ROHC_FLAGS, val[ ROHC_FLAGS ], 0, ROHC_MASK16 ) ){
+        flags |= MIXLINK_ROHC_F_CTRL;
+        (void) memcpy( &o[ at ], &l4[14], 2 );
+        o[ at + 2 ] = l4[13];
+        at += 3;
+      }
+
+      (void) memcpy( &o[ at ], &l4[16], 2 );
+      at += 2;
+    }
+    else if( info.udp_csum ){
+      (void) memcpy( &o[ at ], &l4[6], 2 );
+      at += 2;
+    }
+
+    o[0] = cid;
+    o[1] = flags;
+    o[2] = (uint8_t) mixlink_crc32c( hdr, info.len );
+    (void) memcpy( &o[ at ], &hdr[ info.len ], plen );
+    out->len = at + plen;
+  }
+
+  ctx->count = ( out->val[0] == MIXLINK_ROHC_IR ) ? 0 : ctx->count + 1;
+  ctx->valid = true;
+  ctx->info  = info;
+  (void) memcpy( ctx->key, key, info.len );
+  (void) memcpy( ctx->ref[ ctx->next ], val, sizeof(val) );
+  ctx->next = (uint8_t) ( ( ctx->next + 1 ) % MIXLINK_ROHC_WINDOW );
+  if( MIXLINK_ROHC_WINDOW > ctx->nref )
+    ctx->nref ++;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_rohc_rx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  rohc_t * rohc = (rohc_t *) abi->priv;
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+  if( 2 > in->len || out->size + 1 < in->len ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  const uint8_t type = in->val[0];
+  abi->n_out = 1;
+
+  if( MIXLINK_ROHC_RAW == type ){
+    (void) memcpy( out->val, &in->val[1], in->len - 1 );
+    out->len = in->len - 1;
+    return 0;
+  }
+
+  if( MIXLINK_ROHC_IR == type ){
+    const uint8_t cid = in->val[1];
+    rohc_info_t info;
+    if( MIXLINK_ROHC_CONTEXTS <= cid || !rohc_parse( &in->val[2], in->len - 2, rohc->l2, &info ) ){
+      errno = EBADMSG;
+      return -1;
+    }
+
+    rohc_ctx_t * ctx = &rohc->rx[ cid ];
+    ctx->valid = true;
+    ctx->info  = info;
+    (void) memcpy( ctx->hdr, &in->val[2], info.len );
+    (void) memcpy( out->val, &in->val[2], in->len - 2 );
+    out->len = in->len - 2;
+    return 0;
+  }
+
+  rohc_ctx_t * ctx = ( MIXLINK_ROHC_CONTEXTS > type ) ? &rohc->rx[ type ] : NULL;
+  if( !ctx || !ctx->valid || 3 > in->len ){
+    errno = ENOENT;
+    return -1;
+  }
+
+  const rohc_info_t * info = &ctx->info;
+  const uint8_t flags = in->val[1];
+  const uint8_t * i = in->val;
+  size_t at = 3;
+  uint8_t hdr[ MIXLINK_ROHC_HDR_MAX ];
+  (void) memcpy( hdr, ctx->hdr, info->len );
+  uint8_t * ip = &hdr[ info->ip ];
+  uint8_t * l4 = &hdr[ info->l4 ];
+
+  if( in->len < at + rohc_fields( info, flags ) || out->size < info->len + in->len - at - rohc_fields( info, flags ) ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  // Fields of another protocol or version than the context would shift the ones after them
+  const uint8_t tcp_only = (uint8_t) ~MIXLINK_ROHC_F_IPID;
+  const uint8_t ts = MIXLINK_ROHC_F_TS16 | MIXLINK_ROHC_F_TS32;
+  if( ( ROHC_TCP != info->proto && ( flags & tcp_only ) ) || ( 4 != info->ver && ( flags & MIXLINK_ROHC_F_IPID ) ) || ( !info->ts && ( flags & ts ) ) ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  // Each field is decoded against the last header rebuilt, which is one of the references of the compressor
+  uint32_t val[ ROHC_FIELDS ];
+  rohc_values( hdr, info, val );
+
+  if( 4 == info->ver ){
+    if( MIXLINK_ROHC_F_IPID & flags ){
+      (void) memcpy( &ip[4], &i[ at ], 2 );
+      at += 2;
+    }
+    else
+      put16( &ip[4], (uint16_t) rohc_lsb( val[ ROHC_IPID ], i[ at ++ ], 8, ROHC_MASK16 ) );
+  }
+
+  if( ROHC_TCP == info->proto ){
+    if( MIXLINK_ROHC_F_TS16 & flags ){
+      put32( &l4[24], rohc_lsb( val[ ROHC_TSV ], get16( &i[ at ] ), 16, ROHC_MASK32 ) );
+      put32( &l4[28], rohc_lsb( val[ ROHC_TSE ], get16( &i[ at + 2 ] ), 16, ROHC_MASK32 ) );
+      at += 4;
+    }
+    else if( MIXLINK_ROHC_F_TS32 & flags ){
+      (void) memcpy( &l4[24], &i[ at ], 8 );
+      at += 8;
+    }
+
+    if( MIXLINK_ROHC_F_SEQ16 & flags ){
+      put32( &l4[4], rohc_lsb( val[ ROHC_SEQ ], get16( &i[ at ] ), 16, ROHC_MASK32 ) );
+      at += 2;
+    }
+    else if( MIXLINK_ROHC_F_SEQ32 & flags ){
+      (void) memcpy( &l4[4], &i[ at ], 4 );
+      at += 4;
+    }
+
+    if( MIXLINK_ROHC_F_ACK16 & flags ){
+      put32( &l4[8], rohc_lsb( val[ ROHC_ACK ], get16( &i[ at ] ), 16, ROHC_MASK32 ) );
+      at += 2;
+    }
+    else if( MIXLINK_ROHC_F_ACK32 & flags ){
+      (void) memcpy( &l4[8], &i[ at ], 4 );
+      at += 4;
+    }
+
+    if( MIXLINK_ROHC_F_CTRL & flags ){
+      (void) memcpy( &l4[14], &i[ at ], 2 );
+      l4[13] = i[ at + 2 ];
+      at += 3;
+    }
+
+    (void) memcpy( &l4[16], &i[ at ], 2 );
+    at += 2;
+  }
+  else if( info->udp_csum ){
+    (void) memcpy( &l4[6], &i[ at ], 2 );
+    at += 2;
+  }
+
+  const size_t plen = in->len - at;
+  rohc_finish( hdr, info, plen );
+
+  // A wrong header would reach the NIC, the context stays as it was and the next packets decode against it
+  if( (uint8_t) mixlink_crc32c( hdr, info->len ) != i[2] ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  (void) memcpy( ctx->hdr, hdr, info->len );
+  (void) memcpy( out->val, hdr, info->len );
+  (void) memcpy( &out->val[ info->len ], &i[ at ], plen );
+  out->len = info->len + plen;
+  return 0;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
@@ -0,0 +1,456 @@
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Introduction
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**********************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************//**
+ * @file      tdma.c
+ *
+ * @version   1.0
+ *
+ * @date      16-10-2026
+ *
+ * @brief     Half-duplex turn-taking MAC of the `builtin:tdma` mac stage, by time slots or by a token.
+ *
+ * @author    Fábio D. Pacheco,
+ * @email     fabio.d.pacheco@inesctec.pt or pacheco.castro.fabio@gmail.com
+ *
+ * @copyright Copyright (c) [2025] [Fábio D. Pacheco]
+ *
+ * @note      Manuals: IEEE 802.4 (token passing), IEEE 802.15.4 section 5.1.1.1 (guaranteed time slots).
+ *
+ *            A transceiver cannot hear while it sends, so two nodes sending at once lose both frames. The stage keeps the
+ *            frames until the node may transmit and lets them through one at a time, so none waits in the serial port
+ *            past the turn. With `mode=tdma` every node owns `weight * slot` ms of a superframe, in the order of the
+ *            weights, counted from the wall clock, which the nodes must keep in step, e.g., with NTP or GPS, to well
+ *            under `guard`. With `mode=token` only the holder sends, up to `weight * quantum` bytes, and the token
+ *            rides on its last frame; the TX thread sends and the RX thread takes the token, so the turn is kept under
+ *            a lock.
+ *
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Imported libraries
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "tdma.h"
+#include "builtin.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Data structures
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+typedef struct{
+  uint16_t len;
+  uint8_t data[ MIXLINK_TDMA_FRAME_MAX ];
+} tdma_frame_t;
+
+typedef struct{
+  pthread_mutex_t lock;                                                        //!< Guards the turn, shared with the RX thread
+  bool token;                                                                  //!< `mode=token`, otherwise time slots
+  uint8_t id;
+  uint8_t nodes;
+  uint32_t offset;                                                             //!< Ms from the start of the superframe to the first slot of this node
+  uint32_t block;                                                              //!< Ms of the slots of this node
+  uint32_t frame;                                                              //!< Ms of the superframe, the slots of every node
+  uint32_t guard;
+  uint32_t quota;                                                              //!< Bytes per turn of the token
+  uint32_t gap;
+  uint32_t hold;
+  uint32_t timeout;
+
+  bool holder;                                                                 //!< This node holds the token
+  uint32_t spent;                                                              //!< Bytes sent in this turn
+  uint8_t rounds;                                                              //!< Turns passed in a row with nothing sent
+  uint64_t since;                                                              //!< Last frame sent or the token received, in ms
+  uint64_t heard;                                                              //!< Last sign of the token on the channel, in ms
+
+  tdma_frame_t queue[ MIXLINK_TDMA_QUEUE ];
+  uint32_t head;                                                               //!< Next frame enqueued, the queue is empty when it equals `tail`
+  uint32_t tail;
+} tdma_t;
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Local Prototypes
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+uint64_t tdma_now(
+  const clockid_t clock
+);
+
+int8_t tdma_weights(
+  tdma_t * tdma,
+  const char * args,
+  const uint32_t slot,
+  const uint32_t quantum
+);
+
+int8_t tdma_send(
+  tdma_t * tdma,
+  mixlink_buf8_t * out,
+  const uint8_t hdr
+);
+
+uint32_t tdma_slots(
+  tdma_t * tdma,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+);
+
+uint32_t tdma_turn(
+  tdma_t * tdma,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+);
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Function Description
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint64_t
+tdma_now(
+  const clockid_t clock
+){
+  struct timespec ts;
+  (void) clock_gettime( clock, &ts );
+  return (uint64_t) ts.tv_sec * 1000u + (uint64_t) ts.tv_nsec / 1000000u;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+tdma_weights(
+  tdma_t * tdma,
+  const char * args,
+  const uint32_t slot,
+  const uint32_t quantum
+){
+  char list[ 128 ] = "1,1";
+  (void) mixlink_abi_arg_str( args, "weights", list, sizeof(list) );
+
+  for( char * at = list ; *at ; ){
+    char * end;
+    const long weight = strtol( at, &end, 10 );
+    if( end == at || 0 >= weight || 255 < weight || MIXLINK_TDMA_NODES == tdma->nodes || ( *end && ',' != *end ) )
+      return -1;
+
+    if( tdma->nodes < tdma->id )
+      tdma->offset += (uint32_t) weight * slot;
+    else if( tdma->nodes == tdma->id ){
+      tdma->block = (uint32_t) weight * slot;
+      tdma->quota = (uint32_t) weight * quantum;
+    }
+    tdma->frame += (uint32_t) weight * slot;
+    tdma->nodes ++;
+    at = *end ? end + 1 : end;
+  }
+
+  return ( 2 <= tdma->nodes && tdma->id < tdma->nodes ) ? 0 : -1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+tdma_send(
+  tdma_t * tdma,
+  mixlink_buf8_t * out,
+  const uint8_t hdr
+){
+  // The token alone goes without a frame
+  const tdma_frame_t * frame = ( ( hdr & MIXLINK_TDMA_TOKEN ) && tdma->head == tdma->tail ) ? NULL : &tdma->queue[ tdma->tail & ( MIXLINK_TDMA_QUEUE - 1 ) ];
+  const size_t len = frame ? frame->len : 0;
+  if( out->size < len + 1 ){
+    errno = EMSGSIZE;
+    return -1;
+  }
+
+  out->val[0] = hdr;
+  if( frame ){
+    (void) memcpy( &out->val[1], frame->data, len );
+    tdma->tail ++;
+  }
+  out->len = len + 1;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint32_t
+tdma_slots(
+  tdma_t * tdma,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+){
+  if( tdma->head == tdma->tail )
+    return 0;
+
+  const uint32_t pos = (uint32_t) ( tdma_now( CLOCK_REALTIME ) % tdma->frame );
+  if( pos < tdma->offset || pos >= tdma->offset + tdma->block - tdma->guard )
+    return ( tdma->offset + tdma->frame - pos ) % tdma->frame;
+
+  // One frame at a time, so none is left in the serial port when the slots end
+  while( tdma->head != tdma->tail && *n < abi->n_out && !( abi->backlog + *n ) ){
+    if( -1 == tdma_send( tdma, abi->out[ *n ], tdma->id ) )
+      return 0;
+    ++ *n;
+  }
+
+  abi->drain |= ( tdma->head != tdma->tail );
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+uint32_t
+tdma_turn(
+  tdma_t * tdma,
+  mixlink_abi_gen_io_t * abi,
+  uint8_t * n
+){
+  const uint64_t now = tdma_now( CLOCK_MONOTONIC );
+  const uint64_t lost = (uint64_t) tdma->timeout * ( tdma->id + 1u );
+
+  // Nothing heard for long, the token went with a lost frame, the lowest identifier takes it first
+  if( !tdma->holder && now - tdma->heard >= lost ){
+    tdma->holder = true;
+    tdma->spent = 0;
+    tdma->since = now;
+  }
+
+  if( !tdma->holder )
+    return (uint32_t) ( lost - ( now - tdma->heard ) );
+
+  while( tdma->head != tdma->tail && *n < abi->n_out && !( abi->backlog + *n ) ){
+    const uint16_t len = tdma->queue[ tdma->tail & ( MIXLINK_TDMA_QUEUE - 1 ) ].len;
+    const bool last = ( tdma->spent + len >= tdma->quota );
+    if( -1 == tdma_send( tdma, abi->out[ *n ], (uint8_t) ( tdma->id | ( last ? MIXLINK_TDMA_TOKEN : 0 ) ) ) )
+      return 0;
+
+    ++ *n;
+    tdma->spent += len;
+    tdma->since = now;
+    tdma->rounds = 0;
+    if( last ){
+      tdma->holder = false;
+      tdma->heard = now;
+      return (uint32_t) lost;
+    }
+  }
+
+  if( tdma->head != tdma->tail ){
+    abi->drain = true;
+    return 0;
+  }
+
+  // Frames released by the stages before may still be on their way, the token goes alone after a quiet gap
+  const uint64_t gap = ( (uint64_t) tdma->gap << tdma->rounds < tdma->hold ) ? (uint64_t) tdma->gap << tdma->rounds : tdma->hold;
+  if( now - tdma->since < gap )
+    return (uint32_t) ( gap - ( now - tdma->since ) );
+
+  if( *n == abi->n_out || abi->backlog + *n ){
+    abi->drain = true;
+    return 0;
+  }
+
+  if( -1 == tdma_send( tdma, abi->out[ *n ], (uint8_t) ( tdma->id | MIXLINK_TDMA_TOKEN ) ) )
+    return 0;
+
+  ++ *n;
+  tdma->holder = false;
+  tdma->heard = now;
+  if( 16 > tdma->rounds )
+    tdma->rounds ++;
+  return (uint32_t) lost;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_tdma_init(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  if( def->priv )
+    return 0;
+
+  char mode[ 8 ] = "tdma";
+  (void) mixlink_abi_arg_str( def->args, "mode", mode, sizeof(mode) );
+
+  const long id      = mixlink_abi_arg( def->args, "id", 0 );
+  const long slot    = mixlink_abi_arg( def->args, "slot", MIXLINK_TDMA_SLOT );
+  const long guard   = mixlink_abi_arg( def->args, "guard", MIXLINK_TDMA_GUARD );
+  const long quantum = mixlink_abi_arg( def->args, "quantum", MIXLINK_TDMA_QUANTUM );
+  const long gap     = mixlink_abi_arg( def->args, "gap", MIXLINK_TDMA_GAP );
+  const long hold    = mixlink_abi_arg( def->args, "hold", MIXLINK_TDMA_HOLD );
+  const long timeout = mixlink_abi_arg( def->args, "timeout", MIXLINK_TDMA_TIMEOUT );
+  if( ( strcmp( mode, "tdma" ) && strcmp( mode, "token" ) ) || 0 > id || MIXLINK_TDMA_NODES <= id || 0 >= slot || 60000 < slot || 0 > guard ){
+    errno = EINVAL;
+    return -1;
+  }
+  if( 0 >= quantum || 65535 < quantum || 0 >= gap || gap > hold || 600000 < hold || hold >= timeout || 600000 < timeout ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  tdma_t * tdma = calloc( 1, sizeof(tdma_t) );
+  if( !tdma )
+    return -1;
+
+  tdma->id = (uint8_t) id;
+  if( -1 == tdma_weights( tdma, def->args, (uint32_t) slot, (uint32_t) quantum ) || (uint32_t) guard >= tdma->block ){
+    free( tdma );
+    errno = EINVAL;
+    return -1;
+  }
+
+  const int ret = pthread_mutex_init( &tdma->lock, NULL );
+  if( 0 != ret ){
+    free( tdma );
+    errno = ret;
+    return -1;
+  }
+
+  tdma->token   = !strcmp( mode, "token" );
+  tdma->guard   = (uint32_t) guard;
+  tdma->gap     = (uint32_t) gap;
+  tdma->hold    = (uint32_t) hold;
+  tdma->timeout = (uint32_t) timeout;
+
+  // The first node starts with the token, the others wait to hear from it
+  tdma->holder = ( 0 == tdma->id );
+  tdma->since = tdma->heard = tdma_now( CLOCK_MONOTONIC );
+  def->priv = tdma;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_tdma_deinit(
+  void * arg
+){
+  mixlink_abi_def_t * def = (mixlink_abi_def_t *) arg;
+  if( !def ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  tdma_t * tdma = (tdma_t *) def->priv;
+  if( tdma ){
+    (void) pthread_mutex_destroy( &tdma->lock );
+    free( tdma );
+  }
+
+  def->priv = NULL;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_tdma_tx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  tdma_t * tdma = (tdma_t *) abi->priv;
+
+  if( abi->n_in ){
+    const mixlink_buf8_t * in = abi->in[0];
+    if( MIXLINK_TDMA_FRAME_MAX < in->len ){
+      errno = EMSGSIZE;
+      return -1;
+    }
+    // The core stops feeding a full queue, only a frame it already had in hand is lost
+    if( MIXLINK_TDMA_QUEUE == tdma->head - tdma->tail ){
+      abi->full = true;
+      errno = ENOBUFS;
+      return -1;
+    }
+
+    tdma_frame_t * frame = &tdma->queue[ tdma->head ++ & ( MIXLINK_TDMA_QUEUE - 1 ) ];
+    frame->len = (uint16_t) in->len;
+    (void) memcpy( frame->data, in->val, in->len );
+  }
+
+  uint8_t n = 0;
+  uint32_t wait;
+  if( tdma->token ){
+    (void) pthread_mutex_lock( &tdma->lock );
+    wait = tdma_turn( tdma, abi, &n );
+    (void) pthread_mutex_unlock( &tdma->lock );
+  }
+  else
+    wait = tdma_slots( tdma, abi, &n );
+
+  if( wait && abi->wake )
+    (void) abi->wake( abi->wake_ctx, wait );
+
+  // The stages before count the frames waiting for the turn as queued after them
+  abi->held = tdma->head - tdma->tail;
+  abi->full = ( MIXLINK_TDMA_QUEUE == abi->held );
+  abi->n_out = n;
+  return n ? 0 : 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_builtin_tdma_rx(
+  void * arg
+){
+  mixlink_abi_gen_io_t * abi = (mixlink_abi_gen_io_t *) arg;
+  if( !abi || !abi->priv || !abi->n_in || !abi->n_out ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  tdma_t * tdma = (tdma_t *) abi->priv;
+  const mixlink_buf8_t * in = abi->in[0];
+  mixlink_buf8_t * out = abi->out[0];
+  if( !in->len || out->size + 1 < in->len ){
+    errno = EBADMSG;
+    return -1;
+  }
+
+  const uint8_t hdr = in->val[0];
+  const uint8_t sender = hdr & MIXLINK_TDMA_ID;
+  if( tdma->token && sender != tdma->id ){
+    (void) pthread_mutex_lock( &tdma->lock );
+    const bool was = tdma->holder;
+
+    // Any other node sending holds the token, unless the frame hands it here
+    tdma->holder = ( hdr & MIXLINK_TDMA_TOKEN ) && ( sender + 1 ) % tdma->nodes == tdma->id;
+    tdma->heard = tdma_now( CLOCK_MONOTONIC );
+    if( tdma->holder && !was ){
+      tdma->spent = 0;
+      tdma->since = tdma->heard;
+    }
+    if( 1 < in->len )
+      tdma->rounds = 0;
+    const bool got = tdma->holder && !was;
+    (void) pthread_mutex_unlock( &tdma->lock );
+
+    if( got && abi->wake_reverse )
+      (void) abi->wake_reverse( abi->wake_reverse_ctx, 0 );
+  }
+
+  if( 1 == in->len )
+    return 1;
+
+  (void) memcpy( out->val, &in->val[1], in->len - 1 );
+  out->len = in->len - 1;
+  abi->n_out = 1;
+  return 0;
+}
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * End of file
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
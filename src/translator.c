@@ -24,31 +24,178 @@
  * Imported libraries
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h> 
+#include <strings.h>
 #include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
 #include <netinet/in.h>
 #include <netinet/ether.h>
 #include <linux/if_packet.h> 
+#include <linux/filter.h>
 #include <net/if.h>
+#include <linux/if_tun.h>
 
 #include "translator.h"
+#include "pool.h"
+
+/***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
+ * Socket filters
+ **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
+
+//!< Drops the frames sent by this host, including the ones injected by mixlink
+static const struct sock_filter filter_outgoing[ ] = {
+  BPF_STMT( BPF_LD  | BPF_W   | BPF_ABS, (uint32_t) SKF_AD_OFF + SKF_AD_PKTTYPE ),
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , PACKET_OUTGOING, 0, 1 ),
+  BPF_STMT( BPF_RET | BPF_K            , 0 ),
+};
+
+static const struct sock_filter filter_ipv6[ ] = {
+  BPF_STMT( BPF_LD  | BPF_H   | BPF_ABS, 12 ),
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , ETH_P_IPV6, 0, 1 ),
+  BPF_STMT( BPF_RET | BPF_K            , 0 ),
+};
+
+//!< ICMPv6 router and neighbour discovery, types 133 to 137, without extension headers
+static const struct sock_filter filter_nd[ ] = {
+  BPF_STMT( BPF_LD  | BPF_H   | BPF_ABS, 12 ),
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , ETH_P_IPV6, 0, 6 ),
+  BPF_STMT( BPF_LD  | BPF_B   | BPF_ABS, 20 ),
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , IPPROTO_ICMPV6, 0, 4 ),
+  BPF_STMT( BPF_LD  | BPF_B   | BPF_ABS, 54 ),
+  BPF_JUMP( BPF_JMP | BPF_JGE | BPF_K  , 133, 0, 2 ),
+  BPF_JUMP( BPF_JMP | BPF_JGT | BPF_K  , 137, 1, 0 ),
+  BPF_STMT( BPF_RET | BPF_K            , 0 ),
+};
+
+//!< UDP to a destination port, over IPv4 (first fragment only) or IPv6 without extension headers
+#define FILTER_UDP_PORT(port) {                                         \
+  BPF_STMT( BPF_LD  | BPF_H   | BPF_ABS, 12 ),                          \
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , ETH_P_IP, 0, 7 ),              \
+  BPF_STMT( BPF_LD  | BPF_B   | BPF_ABS, 23 ),                          \
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , IPPROTO_UDP, 0, 11 ),          \
+  BPF_STMT( BPF_LD  | BPF_H   | BPF_ABS, 20 ),                          \
+  BPF_JUMP( BPF_JMP | BPF_JSET| BPF_K  , 0x1fff, 9, 0 ),                \
+  BPF_STMT( BPF_LDX | BPF_B   | BPF_MSH, 14 ),                          \
+  BPF_STMT( BPF_LD  | BPF_H   | BPF_IND, 16 ),                          \
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , port, 5, 6 ),                  \
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , ETH_P_IPV6, 0, 5 ),            \
+  BPF_STMT( BPF_LD  | BPF_B   | BPF_ABS, 20 ),                          \
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , IPPROTO_UDP, 0, 3 ),           \
+  BPF_STMT( BPF_LD  | BPF_H   | BPF_ABS, 56 ),                          \
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , port, 0, 1 ),                  \
+  BPF_STMT( BPF_RET | BPF_K            , 0 ),                           \
+}
+
+static const struct sock_filter filter_mdns[ ]  = FILTER_UDP_PORT( 5353 );
+static const struct sock_filter filter_llmnr[ ] = FILTER_UDP_PORT( 5355 );
+
+//!< IEEE 802.3 frames carry a length instead of an EtherType, e.g., STP BPDUs over LLC
+static const struct sock_filter filter_stp[ ] = {
+  BPF_STMT( BPF_LD  | BPF_H   | BPF_ABS, 12 ),
+  BPF_JUMP( BPF_JMP | BPF_JGT | BPF_K  , ETH_DATA_LEN, 1, 0 ),
+  BPF_STMT( BPF_RET | BPF_K            , 0 ),
+};
+
+static const struct sock_filter filter_lldp[ ] = {
+  BPF_STMT( BPF_LD  | BPF_H   | BPF_ABS, 12 ),
+  BPF_JUMP( BPF_JMP | BPF_JEQ | BPF_K  , ETH_P_LLDP, 0, 1 ),
+  BPF_STMT( BPF_RET | BPF_K            , 0 ),
+};
+
+#define FILTER_CLASS(name) { #name, filter_##name, sizeof(filter_##name) / sizeof(struct sock_filter) }
+
+//!< Traffic classes accepted by `<translator><filter><drop>`
+static const struct{
+  const char * name;
+  const struct sock_filter * code;
+  size_t len;
+} filter_class[ ] = {
+  FILTER_CLASS( ipv6 ),
+  FILTER_CLASS( nd ),
+  FILTER_CLASS( mdns ),
+  FILTER_CLASS( llmnr ),
+  FILTER_CLASS( stp ),
+  FILTER_CLASS( lldp ),
+};
+
+#define FILTER_CLASSES ( sizeof(filter_class) / sizeof(filter_class[0]) )
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
  * Local Prototypes
  **************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 
+enum nic_rings{
+  NIC_RING_NONE = 0,
+  NIC_RING_RX   = 1 << 0,
+  NIC_RING_TX   = 1 << 1,
+};
+
 int rawsocket( 
-  const char * interface
+  const char * interface,
+  const uint16_t protocol
+);
+
+bool param_true(
+  const char * value
+);
+
+void * nic_ring_map(
+  const int soc,
+  const size_t len
+);
+
+int8_t nic_ring_rx(
+  struct nic_handler * nic
+);
+
+int8_t nic_ring_tx(
+  struct nic_handler * nic
+);
+
+void nic_ring_close(
+  struct nic_handler * nic
+);
+
+struct nic_handler * translator_nic(
+  const enum direction dir,
+  const mixlink_translator_t * translator
+);
+
+int tundevice(
+  const char * name,
+  const enum nic_backend backend
+);
+
+int8_t try_init_tun(
+  struct nic_handler * nic,
+  mixlink_param_dev_t  param,
+  const enum nic_backend backend
+);
+
+int8_t filter_load(
+  struct sock_fprog * prog,
+  const char * path
+);
+
+int8_t filter_build(
+  struct sock_fprog * prog,
+  const mixlink_param_translator_t * param
 );
 
 int8_t try_init_nic(
   struct nic_handler * nic,
-  mixlink_param_dev_t  param
+  mixlink_param_dev_t  param,
+  const uint8_t rings,
+  const struct sock_fprog * filter
 );
 
 int8_t translator_valid( 
@@ -62,7 +209,8 @@ int8_t translator_valid(
 /**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/
 int
 rawsocket( 
-  const char * interface
+  const char * interface,
+  const uint16_t protocol
 ){
 
   if( !interface ){
@@ -75,7 +223,7 @@ rawsocket(
   int rs = socket( 
     AF_PACKET, 
     SOCK_RAW, 
-    htons(ETH_P_ALL)
+    htons(protocol)
   );
   if( 0 > rs )
     return -1;
@@ -88,7 +236,7 @@ rawsocket(
 
   memset( &socaddr, 0, sizeof(socaddr) );
   socaddr.sll_family = AF_PACKET;
-  socaddr.sll_protocol = htons(ETH_P_ALL);
+  socaddr.sll_protocol = htons(protocol);
   socaddr.sll_ifindex = ifindex;
 
   int bd = bind( 
@@ -104,11 +252,324 @@ rawsocket(
   return rs;
 }
 
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int
+tundevice(
+  const char * name,
+  const enum nic_backend backend
+){
+
+  if( !name ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  const int fd = open( MIXLINK_NIC_TUN_PATH, O_RDWR | O_NONBLOCK | O_CLOEXEC );
+  if( 0 > fd )
+    return -1;
+
+  // Older kernels reject the optional flags, they are dropped one at a time
+  const short base = (short) ( ( NIC_BACKEND_TAP == backend ? IFF_TAP : IFF_TUN ) | IFF_NO_PI );
+  const short extra[ ] = { IFF_MULTI_QUEUE | IFF_NAPI, IFF_MULTI_QUEUE, 0 };
+
+  struct ifreq ifr;
+  int ret = -1;
+  for( size_t i = 0 ; i < sizeof(extra) / sizeof(extra[0]) && -1 == ret ; ++i ){
+    (void) memset( &ifr, 0, sizeof(ifr) );
+    (void) strncpy( ifr.ifr_name, name, IFNAMSIZ - 1 );
+    ifr.ifr_flags = (short) ( base | extra[i] );
+    ret = ioctl( fd, TUNSETIFF, &ifr );
+    if( -1 == ret && EINVAL != errno && EPERM != errno )
+      break;
+  }
+
+  if( -1 == ret ){
+    (void) close( fd );
+    return -1;
+  }
+
+  // The device is created down, bringing it up is the only configuration done here
+  const int ctl = socket( AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0 );
+  if( 0 <= ctl ){
+    if( -1 != ioctl( ctl, SIOCGIFFLAGS, &ifr ) ){
+      ifr.ifr_flags = (short) ( ifr.ifr_flags | IFF_UP | IFF_RUNNING );
+      if( -1 == ioctl( ctl, SIOCSIFFLAGS, &ifr ) )
+        warning_print( "could not bring %s up", name );
+    }
+    (void) close( ctl );
+  }
+
+  return fd;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+try_init_tun(
+  struct nic_handler * nic,
+  mixlink_param_dev_t  param,
+  const enum nic_backend backend
+){
+
+  if( !nic ){
+    errno = EINVAL;
+    return -1;
+  }
+
+  const int fd = tundevice( param.name, backend );
+  if( -1 == fd )
+    return -1;
+
+  nic->soc = fd;
+  nic->enabled = true;
+  nic->backend = backend;
+  nic->ring.tx_soc = -1;
+  (void) strncpy( nic->name, param.name, NAME_MAX );
+  nic->name[ NAME_MAX - 1 ] = '\0'; 
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+param_true(
+  const char * value
+){
+  return !strcasecmp( value, "true" ) || !strcasecmp( value, "yes" ) || 
+         !strcasecmp( value, "on" )   || !strcmp( value, "1" );
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void *
+nic_ring_map(
+  const int soc,
+  const size_t len
+){
+  void * map = mmap( NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, soc, 0 );
+
+  // RLIMIT_MEMLOCK often refuses to lock the ring, it still works unlocked
+  if( MAP_FAILED == map )
+    map = mmap( NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, soc, 0 );
+
+  return map;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+nic_ring_rx(
+  struct nic_handler * nic
+){
+  const int version = TPACKET_V3;
+  if( -1 == setsockopt( nic->soc, SOL_PACKET, PACKET_VERSION, &version, sizeof(version) ) )
+    return -1;
+
+  struct tpacket_req3 req;
+  (void) memset( &req, 0, sizeof(req) );
+  req.tp_block_size = MIXLINK_NIC_RX_BLOCK_SIZE;
+  req.tp_block_nr = MIXLINK_NIC_RX_BLOCKS;
+  req.tp_frame_size = MIXLINK_NIC_FRAME_SIZE;
+  req.tp_frame_nr = ( MIXLINK_NIC_RX_BLOCK_SIZE / MIXLINK_NIC_FRAME_SIZE ) * MIXLINK_NIC_RX_BLOCKS;
+  req.tp_retire_blk_tov = MIXLINK_NIC_RX_RETIRE_MS;
+
+  void * map = MAP_FAILED;
+  if( -1 != setsockopt( nic->soc, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req) ) )
+    map = nic_ring_map( nic->soc, (size_t) MIXLINK_NIC_RX_BLOCK_SIZE * MIXLINK_NIC_RX_BLOCKS );
+
+  if( MAP_FAILED == map ){
+    // The kernel would keep delivering into the unmapped ring, it goes away so plain reads get the frames
+    const int err = errno;
+    const int plain = TPACKET_V1;
+    (void) memset( &req, 0, sizeof(req) );
+    (void) setsockopt( nic->soc, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req) );
+    (void) setsockopt( nic->soc, SOL_PACKET, PACKET_VERSION, &plain, sizeof(plain) );
+    errno = err;
+    return -1;
+  }
+
+  nic->ring.rx = (uint8_t *) map;
+  nic->ring.rx_block = 0;
+  nic->ring.rx_left = 0;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+nic_ring_tx(
+  struct nic_handler * nic
+){
+  // Protocol 0 binds to the NIC without receiving anything
+  const int soc = rawsocket( nic->name, 0 );
+  if( -1 == soc )
+    return -1;
+
+  const int version = TPACKET_V2;
+  struct tpacket_req req;
+  (void) memset( &req, 0, sizeof(req) );
+  req.tp_block_size = MIXLINK_NIC_RX_BLOCK_SIZE;
+  req.tp_frame_size = MIXLINK_NIC_FRAME_SIZE;
+  req.tp_frame_nr = MIXLINK_NIC_TX_FRAMES;
+  req.tp_block_nr = ( MIXLINK_NIC_TX_FRAMES * MIXLINK_NIC_FRAME_SIZE ) / MIXLINK_NIC_RX_BLOCK_SIZE;
+
+  void * map = MAP_FAILED;
+  if( -1 != setsockopt( soc, SOL_PACKET, PACKET_VERSION, &version, sizeof(version) ) &&
+      -1 != setsockopt( soc, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req) ) )
+    map = nic_ring_map( soc, (size_t) MIXLINK_NIC_TX_FRAMES * MIXLINK_NIC_FRAME_SIZE );
+
+  if( MAP_FAILED == map ){
+    (void) close( soc );
+    return -1;
+  }
+
+  nic->ring.tx_soc = soc;
+  nic->ring.tx = (uint8_t *) map;
+  nic->ring.tx_frame = 0;
+  nic->ring.tx_pending = 0;
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+nic_ring_close(
+  struct nic_handler * nic
+){
+  if( nic->ring.rx ){
+    (void) munmap( nic->ring.rx, (size_t) MIXLINK_NIC_RX_BLOCK_SIZE * MIXLINK_NIC_RX_BLOCKS );
+    nic->ring.rx = NULL;
+  }
+
+  if( nic->ring.tx ){
+    (void) munmap( nic->ring.tx, (size_t) MIXLINK_NIC_TX_FRAMES * MIXLINK_NIC_FRAME_SIZE );
+    (void) close( nic->ring.tx_soc );
+    nic->ring.tx = NULL;
+    nic->ring.tx_soc = -1;
+  }
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+struct nic_handler *
+translator_nic(
+  const enum direction dir,
+  const mixlink_translator_t * translator
+){
+  mixlink_translator_t * t = (mixlink_translator_t *) translator;
+
+  if( t->def.enabled )
+    return &t->def;
+
+  if( MIXLINK_DIRECTION_FROM_NIC == dir && t->pair.tx.enabled )
+    return &t->pair.tx;
+
+  if( MIXLINK_DIRECTION_TO_NIC == dir && t->pair.rx.enabled )
+    return &t->pair.rx;
+
+  return NULL;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+filter_load(
+  struct sock_fprog * prog,
+  const char * path
+){
+  FILE * file = fopen( path, "r" );
+  if( !file )
+    return -1;
+
+  // The outgoing guard is written first, the relative jumps of the program are not affected
+  const size_t guard = sizeof(filter_outgoing) / sizeof(filter_outgoing[0]);
+  unsigned int n = 0;
+  if( 1 != fscanf( file, "%u", &n ) || !n || BPF_MAXINSNS < n + guard ){
+    (void) fclose( file );
+    errno = EINVAL;
+    return -1;
+  }
+
+  prog->filter = calloc( n + guard, sizeof(struct sock_filter) );
+  if( !prog->filter ){
+    (void) fclose( file );
+    errno = ENOMEM;
+    return -1;
+  }
+  (void) memcpy( prog->filter, filter_outgoing, sizeof(filter_outgoing) );
+
+  for( unsigned int i = 0 ; i < n ; ++i ){
+    unsigned int code, jt, jf, k;
+    if( 4 != fscanf( file, "%u %u %u %u", &code, &jt, &jf, &k ) ){
+      (void) fclose( file );
+      free( prog->filter );
+      prog->filter = NULL;
+      errno = EINVAL;
+      return -1;
+    }
+    prog->filter[ guard + i ] = (struct sock_filter) BPF_JUMP( (uint16_t) code, k, (uint8_t) jt, (uint8_t) jf );
+  }
+
+  (void) fclose( file );
+  prog->len = (unsigned short) ( n + guard );
+  return 0;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+filter_build(
+  struct sock_fprog * prog,
+  const mixlink_param_translator_t * param
+){
+  (void) memset( prog, 0, sizeof(struct sock_fprog) );
+
+  if( param->filter.program[0] )
+    return filter_load( prog, param->filter.program );
+
+  size_t total = sizeof(filter_outgoing) / sizeof(filter_outgoing[0]) + 1;
+  for( size_t k = 0 ; k < FILTER_CLASSES ; ++k )
+    total += filter_class[k].len;
+
+  prog->filter = calloc( total, sizeof(struct sock_filter) );
+  if( !prog->filter ){
+    errno = ENOMEM;
+    return -1;
+  }
+
+  size_t n = sizeof(filter_outgoing) / sizeof(filter_outgoing[0]);
+  (void) memcpy( prog->filter, filter_outgoing, sizeof(filter_outgoing) );
+
+  char list[ NAME_MAX ];
+  (void) strncpy( list, param->filter.drop, NAME_MAX );
+  list[ NAME_MAX - 1 ] = '\0';
+
+  // `total` holds each class once, a class named twice is emitted once
+  uint32_t seen = 0;
+  char * save = NULL;
+  for( char * tok = strtok_r( list, ", ", &save ) ; tok ; tok = strtok_r( NULL, ", ", &save ) ){
+    size_t k = 0;
+    for( ; k < FILTER_CLASSES ; ++k )
+      if( !strcasecmp( tok, filter_class[k].name ) )
+        break;
+
+    if( FILTER_CLASSES == k ){
+      warning_print( "unknown filter class %s", tok );
+      continue;
+    }
+
+    if( seen & ( 1u << k ) )
+      continue;
+    seen |= 1u << k;
+
+    // Each block is self-contained, it drops on a match and falls through to the next block otherwise
+    (void) memcpy( &prog->filter[n], filter_class[k].code, filter_class[k].len * sizeof(struct sock_filter) );
+    n += filter_class[k].len;
+  }
+
+  prog->filter[ n ++ ] = (struct sock_filter) BPF_STMT( BPF_RET | BPF_K, 0x40000 );
+  prog->len = (unsigned short) n;
+  return 0;
+}
+
 /**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
 int8_t 
 try_init_nic(
   struct nic_handler * nic,
-  mixlink_param_dev_t  param
+  mixlink_param_dev_t  param,
+  const uint8_t rings,
+  const struct sock_fprog * filter
 ){
   
   if( !nic ){
@@ -116,12 +577,23 @@ try_init_nic(
     return -1;
   }
 
-  int soc = rawsocket( param.name );
+  int soc = rawsocket( param.name, ETH_P_ALL );
   if( -1 != soc ){
     nic->soc = soc;
     nic->enabled = true;
+    nic->ring.tx_soc = -1;
     (void) strncpy( nic->name, param.name, NAME_MAX );
     nic->name[ NAME_MAX - 1 ] = '\0'; 
+
+    // Attached before the rings, so the kernel never maps a frame the filter would drop
+    if( filter && filter->filter && -1 == setsockopt( soc, SOL_SOCKET, SO_ATTACH_FILTER, filter, sizeof(struct sock_fprog) ) )
+      warning_print( "no socket filter on %s", nic->name );
+
+    // The rings are an optimization, the plain socket keeps working without them
+    if( (rings & NIC_RING_RX) && -1 == nic_ring_rx( nic ) )
+      warning_print( "no RX ring on %s", nic->name );
+    if( (rings & NIC_RING_TX) && -1 == nic_ring_tx( nic ) )
+      warning_print( "no TX ring on %s", nic->name );
     return 0;
   }
   
@@ -155,32 +627,70 @@ mixlink_translator_init(
   (void) memset( translator, 0, sizeof(mixlink_translator_t) );
 
   bool failed2soc = true;
+  const bool mmap = param_true( param.mmap );
+
+  // A TUN/TAP device only carries what the kernel routes to it, neither the rings nor the filter apply
+  enum nic_backend backend = NIC_BACKEND_SOCKET;
+  if( !strcasecmp( param.backend, "tun" ) )
+    backend = NIC_BACKEND_TUN;
+  else if( !strcasecmp( param.backend, "tap" ) )
+    backend = NIC_BACKEND_TAP;
+  else if( param.backend[0] && strcasecmp( param.backend, "socket" ) )
+    warning_print( "unknown backend %s, using socket", param.backend );
+
+  if( NIC_BACKEND_SOCKET != backend ){
+    if( -1 == try_init_tun( &translator->def, param.nic.def, backend ) )
+      return -1;
+    goto modules;
+  }
+
+  struct sock_fprog filter;
+  if( -1 == filter_build( &filter, &param ) )
+    warning_print( "socket filter %s", param.filter.program );
   
   int8_t ret = try_init_nic( 
     &translator->def,
-    param.nic.def
+    param.nic.def,
+    mmap ? (NIC_RING_RX | NIC_RING_TX) : NIC_RING_NONE,
+    &filter
   );
 
   if( -1 == ret ){
-    if( !try_init_nic( &translator->pair.rx, param.nic.pair.rx ) )
+    if( !try_init_nic( &translator->pair.rx, param.nic.pair.rx, mmap ? NIC_RING_TX : NIC_RING_NONE, &filter ) )
       failed2soc = false;
-    if( !try_init_nic( &translator->pair.tx, param.nic.pair.tx ) )
+    if( !try_init_nic( &translator->pair.tx, param.nic.pair.tx, mmap ? NIC_RING_RX : NIC_RING_NONE, &filter ) )
       failed2soc = false;
   }
   else
     failed2soc = false;
 
+  // The kernel keeps its own copy of the program
+  free( filter.filter );
+
   if( failed2soc ){
     errno = EINVAL;    
     return -1;
   }
 
+  modules:
+  (void) mixlink_mod_load( 
+    param.mac, 
+    MIXLINK_STACK_SECTION_TRANSLATOR_MAC,
+    &translator->mac
+  );
+
   (void) mixlink_mod_load( 
     param.opt, 
     MIXLINK_STACK_SECTION_TRANSLATOR_OPT,
     &translator->opt
   );
 
+  (void) mixlink_mod_load( 
+    param.comp, 
+    MIXLINK_STACK_SECTION_TRANSLATOR_COMP,
+    &translator->comp
+  );
+
   (void) mixlink_mod_load(
     param.framer, 
     MIXLINK_STACK_SECTION_TRANSLATOR_FRAMER,
@@ -208,13 +718,16 @@ mixlink_translator_close(
 
   for( int8_t i = 0; i < n_nics ; ++i ){
     if( nics[i]->enabled && 0 <= nics[i]->soc ){
+      nic_ring_close( nics[i] );
       (void) close( nics[i]->soc );
       nics[i]->enabled = false;
       nics[i]->soc = -1;
     }
   }
 
+  (void) mixlink_mod_unload( &translator->mac );
   (void) mixlink_mod_unload( &translator->opt );
+  (void) mixlink_mod_unload( &translator->comp );
   (void) mixlink_mod_unload( &translator->framer );
 
   return 0;
@@ -240,11 +753,17 @@ mixlink_translator_write(
     return 0;
   }
 
-  return (size_t) write( 
+  // Slices are gathered by the kernel, the frame is never flattened in user space
+  struct iovec iov[ MIXLINK_BUF_MAX_IOV ];
+  const ssize_t n = writev( 
     soc,
-    data->val,
-    data->len
+    iov,
+    (int) mixlink_buf8_iov( data, iov )
   );
+  if( 0 > n )
+    return 0;
+
+  return (size_t) n;
 }
 
 /**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
@@ -279,11 +798,303 @@ mixlink_translator_read(
     return 0;
   }
 
-  return (size_t) read( 
+  const ssize_t n = read( 
     soc, 
     &data->val[offset], 
-    data->len
+    len
   ); 
+  if( 0 > n )
+    return 0;
+
+  return (size_t) n;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+mixlink_translator_write_batch(
+  const mixlink_translator_t * translator,
+  mixlink_buf8_t * const * data,
+  const size_t n
+){
+
+  if( -1 == translator_valid( translator ) )  
+    return 0;
+
+  if( !data ){
+    errno = EINVAL;
+    return 0;
+  }
+
+  const struct nic_handler * nic = translator_nic( MIXLINK_DIRECTION_TO_NIC, translator );
+  if( !nic ){
+    errno = EINVAL;
+    return 0;
+  }
+
+  const size_t count = ( n < MIXLINK_NIC_BATCH ) ? n : MIXLINK_NIC_BATCH;
+
+  // A TUN/TAP queue is not a socket, each packet is a write of its own
+  if( NIC_BACKEND_SOCKET != nic->backend ){
+    size_t i = 0;
+    for( ; i < count ; ++i ){
+      struct iovec iov[ MIXLINK_BUF_MAX_IOV ];
+      const int niov = (int) mixlink_buf8_iov( data[i], iov );
+      if( (ssize_t) mixlink_buf8_total( data[i] ) != writev( nic->soc, iov, niov ) )
+        break;
+    }
+    return i;
+  }
+
+  struct mmsghdr msg[ MIXLINK_NIC_BATCH ];
+  struct iovec iov[ MIXLINK_NIC_BATCH ][ MIXLINK_BUF_MAX_IOV ];
+
+  (void) memset( msg, 0, count * sizeof(struct mmsghdr) );
+  for( size_t i = 0 ; i < count ; ++i ){
+    msg[i].msg_hdr.msg_iov = iov[i];
+    msg[i].msg_hdr.msg_iovlen = mixlink_buf8_iov( data[i], iov[i] );
+  }
+
+  const int sent = sendmmsg( nic->soc, msg, (unsigned int) count, 0 );
+  if( 0 > sent )
+    return 0;
+
+  return (size_t) sent;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+size_t
+mixlink_translator_read_batch( 
+  mixlink_buf8_t * const * data,
+  const size_t n,
+  const mixlink_translator_t * translator
+){
+
+  if( -1 == translator_valid( translator ) )  
+    return 0;
+
+  if( !data || !n ){
+    errno = EINVAL;
+    return 0;
+  }
+
+  const struct nic_handler * nic = translator_nic( MIXLINK_DIRECTION_FROM_NIC, translator );
+  if( !nic ){
+    errno = EINVAL;
+    return 0;
+  }
+
+  const size_t count = ( n < MIXLINK_NIC_BATCH ) ? n : MIXLINK_NIC_BATCH;
+
+  // The queue is non-blocking, reading stops at the first empty read
+  if( NIC_BACKEND_SOCKET != nic->backend ){
+    size_t i = 0;
+    for( ; i < count ; ++i ){
+      const ssize_t got = read( nic->soc, data[i]->val, data[i]->size );
+      if( 0 >= got )
+        break;
+      data[i]->len = (size_t) got;
+    }
+    if( !i && ( EAGAIN == errno || EWOULDBLOCK == errno ) )
+      errno = 0;
+    return i;
+  }
+
+  struct mmsghdr msg[ MIXLINK_NIC_BATCH ];
+  struct iovec iov[ MIXLINK_NIC_BATCH ];
+
+  (void) memset( msg, 0, count * sizeof(struct mmsghdr) );
+  for( size_t i = 0 ; i < count ; ++i ){
+    iov[i].iov_base = data[i]->val;
+    iov[i].iov_len = data[i]->size;
+    msg[i].msg_hdr.msg_iov = &iov[i];
+    msg[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  const int got = recvmmsg( nic->soc, msg, (unsigned int) count, MSG_DONTWAIT, NULL );
+  if( 0 > got ){
+    if( EAGAIN == errno || EWOULDBLOCK == errno )
+      errno = 0;
+    return 0;
+  }
+
+  for( int i = 0 ; i < got ; ++i )
+    data[i]->len = msg[i].msg_len;
+
+  return (size_t) got;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int
+mixlink_translator_fd(
+  const enum direction dir,
+  const mixlink_translator_t * translator
+){
+
+  if( -1 == translator_valid( translator ) )  
+    return -1;
+
+  const struct nic_handler * nic = translator_nic( dir, translator );
+  return nic ? nic->soc : -1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+bool
+mixlink_translator_ring(
+  const enum direction dir,
+  const mixlink_translator_t * translator
+){
+
+  if( -1 == translator_valid( translator ) )  
+    return false;
+
+  const struct nic_handler * nic = translator_nic( dir, translator );
+  if( !nic )
+    return false;
+
+  return ( MIXLINK_DIRECTION_FROM_NIC == dir ) ? NULL != nic->ring.rx : NULL != nic->ring.tx;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_translator_rx_frame(
+  mixlink_buf8_t * frame,
+  mixlink_translator_t * translator
+){
+
+  if( -1 == translator_valid( translator ) || !frame )  
+    return -1;
+
+  struct nic_handler * nic = translator_nic( MIXLINK_DIRECTION_FROM_NIC, translator );
+  if( !nic || !nic->ring.rx ){
+    errno = ENOTSUP;
+    return -1;
+  }
+
+  struct nic_ring * ring = &nic->ring;
+
+  // Blocks retired by the timeout may carry no packets, they go straight back to the kernel
+  while( !ring->rx_left ){
+    struct tpacket_block_desc * block = (struct tpacket_block_desc *) &ring->rx[ (size_t) ring->rx_block * MIXLINK_NIC_RX_BLOCK_SIZE ];
+    if( !( __atomic_load_n( &block->hdr.bh1.block_status, __ATOMIC_ACQUIRE ) & TP_STATUS_USER ) )
+      return 0;
+
+    if( !block->hdr.bh1.num_pkts ){
+      __atomic_store_n( &block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE );
+      ring->rx_block = ( ring->rx_block + 1 ) % MIXLINK_NIC_RX_BLOCKS;
+      continue;
+    }
+
+    ring->rx_left = block->hdr.bh1.num_pkts;
+    ring->rx_pkt = (uint8_t *) block + block->hdr.bh1.offset_to_first_pkt;
+  }
+
+  const struct tpacket3_hdr * hdr = (const struct tpacket3_hdr *) ring->rx_pkt;
+  frame->val  = ring->rx_pkt + hdr->tp_mac;
+  frame->len  = hdr->tp_snaplen;
+  frame->size = hdr->tp_snaplen;
+  frame->head = 0;
+  frame->n_frag = 0;
+  return 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_translator_rx_release(
+  mixlink_translator_t * translator
+){
+
+  if( -1 == translator_valid( translator ) )  
+    return;
+
+  struct nic_handler * nic = translator_nic( MIXLINK_DIRECTION_FROM_NIC, translator );
+  if( !nic || !nic->ring.rx || !nic->ring.rx_left )
+    return;
+
+  struct nic_ring * ring = &nic->ring;
+  const struct tpacket3_hdr * hdr = (const struct tpacket3_hdr *) ring->rx_pkt;
+  ring->rx_pkt += hdr->tp_next_offset;
+
+  if( --ring->rx_left )
+    return;
+
+  struct tpacket_block_desc * block = (struct tpacket_block_desc *) &ring->rx[ (size_t) ring->rx_block * MIXLINK_NIC_RX_BLOCK_SIZE ];
+  __atomic_store_n( &block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE );
+  ring->rx_block = ( ring->rx_block + 1 ) % MIXLINK_NIC_RX_BLOCKS;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_translator_tx_frame(
+  mixlink_buf8_t * frame,
+  mixlink_translator_t * translator
+){
+
+  if( -1 == translator_valid( translator ) || !frame )  
+    return -1;
+
+  struct nic_handler * nic = translator_nic( MIXLINK_DIRECTION_TO_NIC, translator );
+  if( !nic || !nic->ring.tx ){
+    errno = ENOTSUP;
+    return -1;
+  }
+
+  uint8_t * slot = &nic->ring.tx[ (size_t) nic->ring.tx_frame * MIXLINK_NIC_FRAME_SIZE ];
+  const struct tpacket2_hdr * hdr = (const struct tpacket2_hdr *) slot;
+  if( __atomic_load_n( &hdr->tp_status, __ATOMIC_ACQUIRE ) & (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING) )
+    return 0;
+
+  // The kernel expects the data right after the aligned header, without the sockaddr_ll it reserves on RX
+  const size_t offset = ( sizeof(struct tpacket2_hdr) + TPACKET_ALIGNMENT - 1 ) & ~((size_t) TPACKET_ALIGNMENT - 1);
+  frame->val  = slot + offset;
+  frame->len  = 0;
+  frame->size = MIXLINK_NIC_FRAME_SIZE - offset;
+  frame->head = 0;
+  frame->n_frag = 0;
+  return 1;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+void
+mixlink_translator_tx_commit(
+  const size_t len,
+  mixlink_translator_t * translator
+){
+
+  if( -1 == translator_valid( translator ) )  
+    return;
+
+  struct nic_handler * nic = translator_nic( MIXLINK_DIRECTION_TO_NIC, translator );
+  if( !nic || !nic->ring.tx )
+    return;
+
+  struct tpacket2_hdr * hdr = (struct tpacket2_hdr *) &nic->ring.tx[ (size_t) nic->ring.tx_frame * MIXLINK_NIC_FRAME_SIZE ];
+  hdr->tp_len = (uint32_t) len;
+  __atomic_store_n( &hdr->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE );
+
+  nic->ring.tx_frame = ( nic->ring.tx_frame + 1 ) % MIXLINK_NIC_TX_FRAMES;
+  nic->ring.tx_pending ++;
+}
+
+/**************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************/ 
+int8_t
+mixlink_translator_tx_flush(
+  mixlink_translator_t * translator
+){
+
+  if( -1 == translator_valid( translator ) )  
+    return -1;
+
+  struct nic_handler * nic = translator_nic( MIXLINK_DIRECTION_TO_NIC, translator );
+  if( !nic || !nic->ring.tx ){
+    errno = ENOTSUP;
+    return -1;
+  }
+
+  if( !nic->ring.tx_pending )
+    return 0;
+
+  nic->ring.tx_pending = 0;
+  return ( -1 == send( nic->ring.tx_soc, NULL, 0, MSG_DONTWAIT ) ) ? -1 : 0;
 }
 
 /***************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************************
@@ -298,7 +1109,8 @@ MIXLINK_TRANSLATOR_MODULES
 #undef X
 
 #define X(name) \
-  MIXLINK_GEN_IO_MODULES_IMPL( translator, name, io, mixlink_translator_t )
+  MIXLINK_GEN_IO_MODULES_IMPL( translator, name, io, mixlink_translator_t ) \
+  MIXLINK_GEN_BATCH_MODULES_IMPL( translator, name, batch, mixlink_translator_t )
 MIXLINK_TRANSLATOR_MODULES
 #undef X
 